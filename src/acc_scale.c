@@ -0,0 +1,399 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <armci.h>
+#include <armci_internals.h>
+#include <debug.h>
+
+/** Accumulate scaling kernels.  Each ARMCI accumulate type has a scalar
+  * kernel and, on x86, SSE2, AVX2 and AVX-512 kernels compiled with per
+  * function target attributes.  The kernels used are selected once at
+  * initialization from what the processor supports, so the library itself
+  * does not need to be built for a particular instruction set.
+  */
+
+#ifdef ARMCII_X86_SIMD
+#  include <immintrin.h>
+#endif
+
+typedef void (*ARMCII_Acc_scale_fn)(const void *in, void *out, int nelem, const void *scale);
+
+char ARMCII_Scale_isa_str[][10] = { "SCALAR", "SSE2", "AVX2", "AVX512" };
+
+
+/* -- Scalar kernels -- */
+
+#define SCALE_REAL_SCALAR(NAME, TYPE)                                           \
+static void NAME(const void *in, void *out, int nelem, const void *scale) {     \
+  const TYPE *src = (const TYPE*) in;                                           \
+  TYPE       *dst = (TYPE*) out;                                                \
+  const TYPE  s   = *((const TYPE*) scale);                                     \
+  int j;                                                                        \
+                                                                                \
+  for (j = 0; j < nelem; j++)                                                   \
+    dst[j] = src[j]*s;                                                          \
+}
+
+/* Complex multiplication: (a + bi)*(c + di) */
+#define SCALE_CPLX_SCALAR(NAME, TYPE)                                           \
+static void NAME(const void *in, void *out, int nelem, const void *scale) {     \
+  const TYPE *src = (const TYPE*) in;                                           \
+  TYPE       *dst = (TYPE*) out;                                                \
+  const TYPE  s_r = ((const TYPE*) scale)[0];                                   \
+  const TYPE  s_c = ((const TYPE*) scale)[1];                                   \
+  int j;                                                                        \
+                                                                                \
+  for (j = 0; j < 2*nelem; j += 2) {                                            \
+    const TYPE a = src[j];                                                      \
+    const TYPE b = src[j+1];                                                    \
+    dst[j]   = a*s_r - b*s_c;                                                   \
+    dst[j+1] = b*s_r + a*s_c;                                                   \
+  }                                                                             \
+}
+
+SCALE_REAL_SCALAR(scale_int_scalar, int)
+SCALE_REAL_SCALAR(scale_lng_scalar, long)
+SCALE_REAL_SCALAR(scale_flt_scalar, float)
+SCALE_REAL_SCALAR(scale_dbl_scalar, double)
+SCALE_CPLX_SCALAR(scale_cpl_scalar, float)
+SCALE_CPLX_SCALAR(scale_dcp_scalar, double)
+
+
+#ifdef ARMCII_X86_SIMD
+
+/* Complex kernels multiply each (a, b) pair by s_r and its swapped copy
+ * (b, a) by (-s_c, s_c), which gives (a*s_r - b*s_c, b*s_r + a*s_c) without
+ * horizontal operations.  Tails are finished by the scalar kernels. */
+
+/* -- SSE2 kernels -- */
+
+__attribute__((target("sse2")))
+static void scale_flt_sse2(const void *in, void *out, int nelem, const void *scale) {
+  const float *src = (const float*) in;
+  float       *dst = (float*) out;
+  const __m128 s   = _mm_set1_ps(*((const float*) scale));
+  int j;
+
+  for (j = 0; j + 4 <= nelem; j += 4)
+    _mm_storeu_ps(dst + j, _mm_mul_ps(_mm_loadu_ps(src + j), s));
+
+  scale_flt_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+__attribute__((target("sse2")))
+static void scale_dbl_sse2(const void *in, void *out, int nelem, const void *scale) {
+  const double *src = (const double*) in;
+  double       *dst = (double*) out;
+  const __m128d s   = _mm_set1_pd(*((const double*) scale));
+  int j;
+
+  for (j = 0; j + 2 <= nelem; j += 2)
+    _mm_storeu_pd(dst + j, _mm_mul_pd(_mm_loadu_pd(src + j), s));
+
+  scale_dbl_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+__attribute__((target("sse2")))
+static void scale_cpl_sse2(const void *in, void *out, int nelem, const void *scale) {
+  const float *src = (const float*) in;
+  float       *dst = (float*) out;
+  const float  s_r = ((const float*) scale)[0];
+  const float  s_c = ((const float*) scale)[1];
+  const __m128 v_r = _mm_set1_ps(s_r);
+  const __m128 v_c = _mm_setr_ps(-s_c, s_c, -s_c, s_c);
+  int j;
+
+  for (j = 0; j + 2 <= nelem; j += 2) {
+    const __m128 x = _mm_loadu_ps(src + 2*j);
+    const __m128 y = _mm_shuffle_ps(x, x, _MM_SHUFFLE(2, 3, 0, 1));
+    _mm_storeu_ps(dst + 2*j, _mm_add_ps(_mm_mul_ps(x, v_r), _mm_mul_ps(y, v_c)));
+  }
+
+  scale_cpl_scalar(src + 2*j, dst + 2*j, nelem - j, scale);
+}
+
+__attribute__((target("sse2")))
+static void scale_dcp_sse2(const void *in, void *out, int nelem, const void *scale) {
+  const double *src = (const double*) in;
+  double       *dst = (double*) out;
+  const double  s_r = ((const double*) scale)[0];
+  const double  s_c = ((const double*) scale)[1];
+  const __m128d v_r = _mm_set1_pd(s_r);
+  const __m128d v_c = _mm_setr_pd(-s_c, s_c);
+  int j;
+
+  for (j = 0; j < nelem; j++) {
+    const __m128d x = _mm_loadu_pd(src + 2*j);
+    const __m128d y = _mm_shuffle_pd(x, x, 1);
+    _mm_storeu_pd(dst + 2*j, _mm_add_pd(_mm_mul_pd(x, v_r), _mm_mul_pd(y, v_c)));
+  }
+}
+
+
+/* -- AVX2 kernels -- */
+
+__attribute__((target("avx2")))
+static void scale_int_avx2(const void *in, void *out, int nelem, const void *scale) {
+  const int    *src = (const int*) in;
+  int          *dst = (int*) out;
+  const __m256i s   = _mm256_set1_epi32(*((const int*) scale));
+  int j;
+
+  for (j = 0; j + 8 <= nelem; j += 8)
+    _mm256_storeu_si256((__m256i*) (dst + j),
+        _mm256_mullo_epi32(_mm256_loadu_si256((const __m256i*) (src + j)), s));
+
+  scale_int_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+__attribute__((target("avx2")))
+static void scale_flt_avx2(const void *in, void *out, int nelem, const void *scale) {
+  const float *src = (const float*) in;
+  float       *dst = (float*) out;
+  const __m256 s   = _mm256_set1_ps(*((const float*) scale));
+  int j;
+
+  for (j = 0; j + 8 <= nelem; j += 8)
+    _mm256_storeu_ps(dst + j, _mm256_mul_ps(_mm256_loadu_ps(src + j), s));
+
+  scale_flt_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+__attribute__((target("avx2")))
+static void scale_dbl_avx2(const void *in, void *out, int nelem, const void *scale) {
+  const double *src = (const double*) in;
+  double       *dst = (double*) out;
+  const __m256d s   = _mm256_set1_pd(*((const double*) scale));
+  int j;
+
+  for (j = 0; j + 4 <= nelem; j += 4)
+    _mm256_storeu_pd(dst + j, _mm256_mul_pd(_mm256_loadu_pd(src + j), s));
+
+  scale_dbl_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+__attribute__((target("avx2")))
+static void scale_cpl_avx2(const void *in, void *out, int nelem, const void *scale) {
+  const float *src = (const float*) in;
+  float       *dst = (float*) out;
+  const float  s_r = ((const float*) scale)[0];
+  const float  s_c = ((const float*) scale)[1];
+  const __m256 v_r = _mm256_set1_ps(s_r);
+  const __m256 v_c = _mm256_setr_ps(-s_c, s_c, -s_c, s_c, -s_c, s_c, -s_c, s_c);
+  int j;
+
+  for (j = 0; j + 4 <= nelem; j += 4) {
+    const __m256 x = _mm256_loadu_ps(src + 2*j);
+    const __m256 y = _mm256_permute_ps(x, _MM_SHUFFLE(2, 3, 0, 1));
+    _mm256_storeu_ps(dst + 2*j, _mm256_add_ps(_mm256_mul_ps(x, v_r), _mm256_mul_ps(y, v_c)));
+  }
+
+  scale_cpl_scalar(src + 2*j, dst + 2*j, nelem - j, scale);
+}
+
+__attribute__((target("avx2")))
+static void scale_dcp_avx2(const void *in, void *out, int nelem, const void *scale) {
+  const double *src = (const double*) in;
+  double       *dst = (double*) out;
+  const double  s_r = ((const double*) scale)[0];
+  const double  s_c = ((const double*) scale)[1];
+  const __m256d v_r = _mm256_set1_pd(s_r);
+  const __m256d v_c = _mm256_setr_pd(-s_c, s_c, -s_c, s_c);
+  int j;
+
+  for (j = 0; j + 2 <= nelem; j += 2) {
+    const __m256d x = _mm256_loadu_pd(src + 2*j);
+    const __m256d y = _mm256_permute_pd(x, 0x5);
+    _mm256_storeu_pd(dst + 2*j, _mm256_add_pd(_mm256_mul_pd(x, v_r), _mm256_mul_pd(y, v_c)));
+  }
+
+  scale_dcp_scalar(src + 2*j, dst + 2*j, nelem - j, scale);
+}
+
+
+/* -- AVX-512 kernels -- */
+
+__attribute__((target("avx512f")))
+static void scale_int_avx512(const void *in, void *out, int nelem, const void *scale) {
+  const int    *src = (const int*) in;
+  int          *dst = (int*) out;
+  const __m512i s   = _mm512_set1_epi32(*((const int*) scale));
+  int j;
+
+  for (j = 0; j + 16 <= nelem; j += 16)
+    _mm512_storeu_si512((void*) (dst + j),
+        _mm512_mullo_epi32(_mm512_loadu_si512((const void*) (src + j)), s));
+
+  scale_int_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+/* 64-bit multiply needs AVX-512DQ; only used when long is 64 bits wide */
+__attribute__((target("avx512f,avx512dq")))
+static void scale_lng_avx512(const void *in, void *out, int nelem, const void *scale) {
+  const long   *src = (const long*) in;
+  long         *dst = (long*) out;
+  const __m512i s   = _mm512_set1_epi64(*((const long*) scale));
+  int j;
+
+  for (j = 0; j + 8 <= nelem; j += 8)
+    _mm512_storeu_si512((void*) (dst + j),
+        _mm512_mullo_epi64(_mm512_loadu_si512((const void*) (src + j)), s));
+
+  scale_lng_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+__attribute__((target("avx512f")))
+static void scale_flt_avx512(const void *in, void *out, int nelem, const void *scale) {
+  const float *src = (const float*) in;
+  float       *dst = (float*) out;
+  const __m512 s   = _mm512_set1_ps(*((const float*) scale));
+  int j;
+
+  for (j = 0; j + 16 <= nelem; j += 16)
+    _mm512_storeu_ps(dst + j, _mm512_mul_ps(_mm512_loadu_ps(src + j), s));
+
+  scale_flt_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+__attribute__((target("avx512f")))
+static void scale_dbl_avx512(const void *in, void *out, int nelem, const void *scale) {
+  const double *src = (const double*) in;
+  double       *dst = (double*) out;
+  const __m512d s   = _mm512_set1_pd(*((const double*) scale));
+  int j;
+
+  for (j = 0; j + 8 <= nelem; j += 8)
+    _mm512_storeu_pd(dst + j, _mm512_mul_pd(_mm512_loadu_pd(src + j), s));
+
+  scale_dbl_scalar(src + j, dst + j, nelem - j, scale);
+}
+
+__attribute__((target("avx512f")))
+static void scale_cpl_avx512(const void *in, void *out, int nelem, const void *scale) {
+  const float *src = (const float*) in;
+  float       *dst = (float*) out;
+  const float  s_r = ((const float*) scale)[0];
+  const float  s_c = ((const float*) scale)[1];
+  const __m512 v_r = _mm512_set1_ps(s_r);
+  const __m512 v_c = _mm512_setr_ps(-s_c, s_c, -s_c, s_c, -s_c, s_c, -s_c, s_c,
+                                    -s_c, s_c, -s_c, s_c, -s_c, s_c, -s_c, s_c);
+  int j;
+
+  for (j = 0; j + 8 <= nelem; j += 8) {
+    const __m512 x = _mm512_loadu_ps(src + 2*j);
+    const __m512 y = _mm512_permute_ps(x, _MM_SHUFFLE(2, 3, 0, 1));
+    _mm512_storeu_ps(dst + 2*j, _mm512_add_ps(_mm512_mul_ps(x, v_r), _mm512_mul_ps(y, v_c)));
+  }
+
+  scale_cpl_scalar(src + 2*j, dst + 2*j, nelem - j, scale);
+}
+
+__attribute__((target("avx512f")))
+static void scale_dcp_avx512(const void *in, void *out, int nelem, const void *scale) {
+  const double *src = (const double*) in;
+  double       *dst = (double*) out;
+  const double  s_r = ((const double*) scale)[0];
+  const double  s_c = ((const double*) scale)[1];
+  const __m512d v_r = _mm512_set1_pd(s_r);
+  const __m512d v_c = _mm512_setr_pd(-s_c, s_c, -s_c, s_c, -s_c, s_c, -s_c, s_c);
+  int j;
+
+  for (j = 0; j + 4 <= nelem; j += 4) {
+    const __m512d x = _mm512_loadu_pd(src + 2*j);
+    const __m512d y = _mm512_permute_pd(x, 0x55);
+    _mm512_storeu_pd(dst + 2*j, _mm512_add_pd(_mm512_mul_pd(x, v_r), _mm512_mul_pd(y, v_c)));
+  }
+
+  scale_dcp_scalar(src + 2*j, dst + 2*j, nelem - j, scale);
+}
+
+#endif /* ARMCII_X86_SIMD */
+
+
+/** Kernels indexed by ARMCI accumulate type.
+  */
+static ARMCII_Acc_scale_fn ARMCII_Acc_scale_kernels[] = {
+  scale_int_scalar, scale_lng_scalar, scale_flt_scalar,
+  scale_dbl_scalar, scale_cpl_scalar, scale_dcp_scalar
+};
+
+
+/** Find the widest instruction set the scaling kernels can use on this
+  * processor.
+  */
+enum ARMCII_Scale_isa_e ARMCII_Acc_scale_isa_best(void) {
+#ifdef ARMCII_X86_SIMD
+  __builtin_cpu_init();
+
+  if (__builtin_cpu_supports("avx512f"))
+    return ARMCII_SCALE_AVX512;
+  else if (__builtin_cpu_supports("avx2"))
+    return ARMCII_SCALE_AVX2;
+  else if (__builtin_cpu_supports("sse2"))
+    return ARMCII_SCALE_SSE2;
+#endif
+
+  return ARMCII_SCALE_SCALAR;
+}
+
+
+/** Select the scaling kernels.  Each level also uses the kernels of the levels
+  * below it for types it has no kernel for.
+  *
+  * @param[in] isa Instruction set, no wider than ARMCII_Acc_scale_isa_best()
+  */
+void ARMCII_Acc_scale_init(enum ARMCII_Scale_isa_e isa) {
+  ARMCII_Acc_scale_kernels[ARMCI_ACC_INT] = scale_int_scalar;
+  ARMCII_Acc_scale_kernels[ARMCI_ACC_LNG] = scale_lng_scalar;
+  ARMCII_Acc_scale_kernels[ARMCI_ACC_FLT] = scale_flt_scalar;
+  ARMCII_Acc_scale_kernels[ARMCI_ACC_DBL] = scale_dbl_scalar;
+  ARMCII_Acc_scale_kernels[ARMCI_ACC_CPL] = scale_cpl_scalar;
+  ARMCII_Acc_scale_kernels[ARMCI_ACC_DCP] = scale_dcp_scalar;
+
+#ifdef ARMCII_X86_SIMD
+  if (isa >= ARMCII_SCALE_SSE2) {
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_FLT] = scale_flt_sse2;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_DBL] = scale_dbl_sse2;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_CPL] = scale_cpl_sse2;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_DCP] = scale_dcp_sse2;
+  }
+
+  if (isa >= ARMCII_SCALE_AVX2) {
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_INT] = scale_int_avx2;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_FLT] = scale_flt_avx2;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_DBL] = scale_dbl_avx2;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_CPL] = scale_cpl_avx2;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_DCP] = scale_dcp_avx2;
+  }
+
+  if (isa >= ARMCII_SCALE_AVX512) {
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_INT] = scale_int_avx512;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_FLT] = scale_flt_avx512;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_DBL] = scale_dbl_avx512;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_CPL] = scale_cpl_avx512;
+    ARMCII_Acc_scale_kernels[ARMCI_ACC_DCP] = scale_dcp_avx512;
+
+    if (sizeof(long) == 8 && __builtin_cpu_supports("avx512dq"))
+      ARMCII_Acc_scale_kernels[ARMCI_ACC_LNG] = scale_lng_avx512;
+  }
+#else
+  ARMCII_Assert(isa == ARMCII_SCALE_SCALAR);
+#endif
+}
+
+
+/** Scale nelem elements of an ARMCI accumulate type.
+  *
+  * @param[in]  buf_in   Input buffer
+  * @param[out] buf_out  Output buffer, may not partially overlap buf_in
+  * @param[in]  nelem    Number of elements (complex numbers count as one)
+  * @param[in]  datatype ARMCI accumulate type
+  * @param[in]  scale    Scaling constant of type datatype
+  */
+void ARMCII_Acc_scale(void *buf_in, void *buf_out, int nelem, int datatype, void *scale) {
+  ARMCII_Acc_scale_kernels[datatype](buf_in, buf_out, nelem, scale);
+}
@@ -63,8 +63,9 @@ int   ARMCI_PutS_flag(void *src_ptr, int src_stride_ar[/*stride_levels*/],
 
 typedef struct armci_hdl_s
 {
-    int target;    /* we do not actually support individual completion */
+    int target;    /* last target, used if the handle has no completion record */
     int aggregate;
+    int index;     /* completion record of the handle, -1 if none */
 }
 armci_hdl_t;
 
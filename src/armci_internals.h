@@ -45,6 +45,14 @@
 #endif
 
 
+/* x86 SIMD kernels are compiled with per function target attributes and
+ * selected at run time, so they only need the intrinsics header and GCC
+ * compatible attribute support. */
+#if defined(HAVE_IMMINTRIN_H) && defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#  define ARMCII_X86_SIMD
+#endif
+
+
 /* Disable safety checks if the user asks for it */
 
 #ifdef NO_SEATBELTS
@@ -59,22 +67,31 @@
 
 enum ARMCII_Op_e { ARMCII_OP_PUT, ARMCII_OP_GET, ARMCII_OP_ACC };
 
-enum ARMCII_Strided_methods_e { ARMCII_STRIDED_IOV, ARMCII_STRIDED_DIRECT };
+enum ARMCII_Strided_methods_e { ARMCII_STRIDED_IOV, ARMCII_STRIDED_DIRECT,
+                                ARMCII_STRIDED_PACK, ARMCII_STRIDED_AUTO };
 
 enum ARMCII_Iov_methods_e { ARMCII_IOV_AUTO, ARMCII_IOV_CONSRV,
                             ARMCII_IOV_BATCHED, ARMCII_IOV_DIRECT };
 
 enum ARMCII_Shr_buf_methods_e { ARMCII_SHR_BUF_COPY, ARMCII_SHR_BUF_NOGUARD };
 
+enum ARMCII_Scale_isa_e { ARMCII_SCALE_SCALAR, ARMCII_SCALE_SSE2,
+                          ARMCII_SCALE_AVX2, ARMCII_SCALE_AVX512 };
+
 extern char ARMCII_Strided_methods_str[][10];
 extern char ARMCII_Iov_methods_str[][10];
 extern char ARMCII_Shr_buf_methods_str[][10];
+extern char ARMCII_Scale_isa_str[][10];
 
 typedef struct {
   int           init_count;             /* Number of times ARMCI_Init has been called                           */
   int           debug_alloc;            /* Do extra debuggin on memory allocation                               */
   int           iov_checks;             /* Disable IOV same allocation and overlapping checks                   */
   int           iov_batched_limit;      /* Max number of ops per epoch for BATCHED IOV method                   */
+  int           iov_chunk_len;          /* Number of blocks of a strided IOV operation generated at a time      */
+  int           iov_coalesce;           /* Sort IOV blocks by remote address and merge contiguous blocks        */
+  int           iov_auto_min_count;     /* Fewest IOV blocks issued with a datatype by the AUTO method          */
+  int           iov_auto_max_size;      /* Largest average IOV block issued with a datatype by the AUTO method  */
   int           noncollective_groups;   /* Use noncollective group creation algorithm                           */
   int           cache_rank_translation; /* Enable caching of translation between absolute and group ranks       */
   int           verbose;                /* ARMCI should produce extra status output                             */
@@ -83,15 +100,32 @@ typedef struct {
   int           progress_usleep;        /* Argument to usleep() to throttling polling                           */
 #endif
   int           use_win_allocate;       /* Use win_allocate or win_create                                       */
+  int           use_win_allocate_shared;/* Back allocations with node-level shared memory windows               */
+  int           use_dynamic_window;     /* Attach all allocations on a group to one dynamic window              */
+  int           dynamic_window_attach_limit; /* Most regions attached to a dynamic window (0 is unlimited)      */
+  int           slab_threshold;         /* Largest allocation carved from a slab window (0 disables slabs)      */
+  int           slab_size;              /* Size of each process's slice of a slab window                        */
+  int           use_rma_requests;       /* Issue nonblocking operations with request-based RMA                  */
+  int           strided_dtype_cache;    /* Number of strided datatypes cached (0 disables the cache)            */
+  int           scratch_pool_limit;     /* Most bytes of scratch buffers cached for reuse (0 disables the pool) */
+  int           pack_nt_threshold;      /* Smallest pack/unpack written with non-temporal stores (0 disables)   */
+  int           pack_threads;           /* Most threads used to pack/unpack one large strided patch             */
+  int           large_chunk;            /* Larger contiguous transfers are split into chunks of this many bytes */
   int           explicit_nb_progress;   /* Poke the MPI progress engine at the end of nonblocking (NB) calls    */
   int           use_alloc_shm;          /* Pass alloc_shm info to win_allocate / alloc_mem                      */
-  int           rma_atomicity;          /* Use Accumulate and Get_accumulate for Put and Get                    */
+  int           rma_atomicity;          /* Default put/get atomicity policy of allocations (ARMCIX_ATOMICITY_*) */
   int           end_to_end_flush;       /* All flush_local calls become flush                                   */
   int           rma_nocheck;            /* Use MPI_MODE_NOCHECK on synchronization calls that take assertion    */
+  int           strided_auto_dtypes;    /* AUTO strided method may choose the DIRECT and PACK methods           */
+  double        strided_cost_op;        /* AUTO strided cost model: seconds to issue one RMA operation          */
+  double        strided_cost_dt_block;  /* AUTO strided cost model: seconds per block of a typed operation      */
+  double        strided_cost_dt_byte;   /* AUTO strided cost model: seconds per byte of a typed operation       */
+  double        strided_cost_pack_byte; /* AUTO strided cost model: seconds to pack or unpack one byte          */
 
   enum ARMCII_Strided_methods_e strided_method; /* Strided transfer method              */
   enum ARMCII_Iov_methods_e     iov_method;     /* IOV transfer method                  */
   enum ARMCII_Shr_buf_methods_e shr_buf_method; /* Shared buffer management method      */
+  enum ARMCII_Scale_isa_e       scale_isa;      /* Instruction set of scaling kernels   */
 } global_state_t;
 
 
@@ -165,16 +199,46 @@ void ARMCII_Strided_to_iov(armci_giov_t *iov,
                void *dst_ptr, int dst_stride_ar[/*stride_levels*/],
                int count[/*stride_levels+1*/], int stride_levels);
 
+void ARMCII_Strided_copy(void *src_ptr, int src_stride_ar[/*stride_levels*/],
+               void *dst_ptr, int dst_stride_ar[/*stride_levels*/],
+               int count[/*stride_levels+1*/], int stride_levels);
+
+void ARMCII_Pack_strided(void *src, int src_stride_ar[], int count[], int stride_levels, void *dst);
+void ARMCII_Unpack_strided(void *src, void *dst, int dst_stride_ar[], int count[], int stride_levels);
+
+int  ARMCII_Strided_normalize(int src_stride_ar[], int dst_stride_ar[], int count[], int stride_levels,
+                              int new_src_stride[], int new_dst_stride[], int new_count[]);
+
 void ARMCII_Strided_to_dtype(int stride_array[/*stride_levels*/], int count[/*stride_levels+1*/],
                              int stride_levels, MPI_Datatype old_type, MPI_Datatype *new_type);
+enum ARMCII_Strided_methods_e ARMCII_Strided_method(int count[], int stride_levels);
+void ARMCII_Strided_cost_defaults(void);
+int  ARMCII_Strided_cost_load(const char *path);
+void ARMCII_Strided_calibrate(void);
+
+void ARMCII_Strided_dtype(int stride_ar[], int count[], int stride_levels,
+                          MPI_Datatype old_type, MPI_Datatype *new_type);
+void ARMCII_Contig_dtype(int bytes, MPI_Datatype old_type, MPI_Datatype *new_type);
+void ARMCII_Dense_dtype(int count[], int stride_levels, MPI_Datatype old_type, MPI_Datatype *new_type);
+void ARMCII_Strided_dtype_done(MPI_Datatype *type);
+void ARMCII_Strided_dtype_free_all(void);
 
 int ARMCII_Iov_op_dispatch(enum ARMCII_Op_e op, void **src, void **dst, int count, int size,
     int datatype, int overlapping, int same_alloc, int proc, int blocking);
 
-int ARMCII_Iov_op_batched(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count,
+int ARMCII_Iov_op_vec(enum ARMCII_Op_e op, void **src, void **dst, int count, int bytes,
+    int datatype, void *scale, int proc, int blocking, armci_hdl_t *handle);
+int ARMCII_Strided_iov_op(enum ARMCII_Op_e op, int datatype, void *scale,
+               void *src_ptr, int src_stride_ar[/*stride_levels*/],
+               void *dst_ptr, int dst_stride_ar[/*stride_levels*/],
+               int count[/*stride_levels+1*/], int stride_levels,
+               int proc, int blocking, armci_hdl_t *handle);
+
+int ARMCII_Iov_op_batched(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count[],
     MPI_Datatype type, int proc, int consrv /* if 1, batched = safe */, int blocking);
-int ARMCII_Iov_op_datatype(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count,
+int ARMCII_Iov_op_datatype(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count[],
     MPI_Datatype type, int proc, int blocking);
+void ARMCII_Iov_auto_calibrate(void);
 
 armcii_iov_iter_t *ARMCII_Strided_to_iov_iter(
                void *src_ptr, int src_stride_ar[/*stride_levels*/],
@@ -197,5 +261,29 @@ void ARMCII_Buf_finish_write_vec(void **orig_bufs, void **new_bufs, int count, i
 
 int  ARMCII_Buf_acc_is_scaled(int datatype, void *scale);
 void ARMCII_Buf_acc_scale(void *buf_in, void *buf_out, int size, int datatype, void *scale);
+void ARMCII_Buf_acc_scale_strided(void *src_ptr, int src_stride_ar[], int count[], int stride_levels,
+                                  void *buf_out, int datatype, void *scale);
+
+enum ARMCII_Scale_isa_e ARMCII_Acc_scale_isa_best(void);
+void ARMCII_Acc_scale_init(enum ARMCII_Scale_isa_e isa);
+void ARMCII_Acc_scale(void *buf_in, void *buf_out, int nelem, int datatype, void *scale);
+
+/* Nonblocking handle completion tracking */
+
+struct gmr_s;
+
+void ARMCII_Hdl_begin(armci_hdl_t *handle);
+void ARMCII_Hdl_end(armci_hdl_t *handle, int proc);
+void ARMCII_Hdl_defer(armci_hdl_t *handle, int proc, void *buf, void *unpack_ptr,
+                      int stride_ar[], int count[], int stride_levels);
+void ARMCII_Hdl_retire_implicit(int proc);
+void ARMCII_Hdl_purge(struct gmr_s *owner);
+void ARMCII_Hdl_free_all(void);
+
+/* Scratch buffer pool */
+
+void *ARMCII_Scratch_get(size_t size);
+void  ARMCII_Scratch_put(void *buf);
+void  ARMCII_Scratch_free_all(void);
 
 #endif /* HAVE_ARMCI_INTERNALS_H */
@@ -43,4 +43,49 @@ void ARMCIX_Unlock_hdl(armcix_mutex_hdl_t hdl, int mutex, int proc);
 
 void ARMCIX_Progress(void);
 
+/** I/O vectors whose blocks have individual sizes.  Block i of a descriptor
+  * moves bytes_array[i] bytes from src_ptr_array[i] to dst_ptr_array[i].
+  */
+
+typedef struct {
+  void **src_ptr_array;
+  void **dst_ptr_array;
+  int   *bytes_array;
+  int    ptr_array_len;
+} armcix_giov_irreg_t;
+
+int ARMCIX_PutV_irreg(armcix_giov_irreg_t *iov, int iov_len, int proc);
+int ARMCIX_GetV_irreg(armcix_giov_irreg_t *iov, int iov_len, int proc);
+int ARMCIX_AccV_irreg(int datatype, void *scale, armcix_giov_irreg_t *iov, int iov_len, int proc);
+
+/** Atomicity of put and get operations on an allocation.  With ON, puts and
+  * gets are issued as MPI accumulate operations, which keeps them ordered and
+  * atomic with respect to accumulates.  With OFF, they are issued as plain
+  * MPI puts and gets.  With AUTO, the allocation is atomic until an
+  * ARMCI_Barrier finds that no process has accumulated into (or performed a
+  * read-modify-write on) it, and plain from then on.  Once any process has,
+  * it is atomic again on that process at once and on every process from the
+  * next ARMCI_Barrier on; puts and gets of other processes concurrent with
+  * that first accumulate are not atomic with respect to it.  Allocations on
+  * groups other than the world group stay atomic under AUTO.  The policy
+  * applies to the operations issued by the calling process.
+  */
+
+enum { ARMCIX_ATOMICITY_OFF, ARMCIX_ATOMICITY_ON, ARMCIX_ATOMICITY_AUTO };
+
+int ARMCIX_Set_atomicity(void *ptr, int atomicity);
+int ARMCIX_Get_atomicity(void *ptr);
+
+/** Contiguous transfers whose size may exceed INT_MAX bytes.
+  */
+
+int ARMCIX_Put_large(void *src, void *dst, armci_size_t bytes, int proc);
+int ARMCIX_Get_large(void *src, void *dst, armci_size_t bytes, int proc);
+int ARMCIX_Acc_large(int datatype, void *scale, void *src, void *dst, armci_size_t bytes, int proc);
+
+int ARMCIX_NbPut_large(void *src, void *dst, armci_size_t bytes, int proc, armci_hdl_t *handle);
+int ARMCIX_NbGet_large(void *src, void *dst, armci_size_t bytes, int proc, armci_hdl_t *handle);
+int ARMCIX_NbAcc_large(int datatype, void *scale, void *src, void *dst, armci_size_t bytes, int proc,
+                       armci_hdl_t *handle);
+
 #endif /* _ARMCIX_H_ */
@@ -4,6 +4,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stddef.h>
 #include <math.h>
 #include <float.h>
 
@@ -27,7 +28,7 @@ int ARMCII_Buf_prepare_read_vec(void **orig_bufs, void ***new_bufs_ptr, int coun
   int num_moved = 0;
 
   if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_NOGUARD) {
-    void **new_bufs = malloc(count*sizeof(void*));
+    void **new_bufs = ARMCII_Scratch_get(count*sizeof(void*));
     int i;
 
     for (i = 0; i < count; i++)
@@ -39,7 +40,7 @@ int ARMCII_Buf_prepare_read_vec(void **orig_bufs, void ***new_bufs_ptr, int coun
       gmr_t *mreg = gmr_lookup(orig_bufs[i], ARMCI_GROUP_WORLD.rank);
 
       if (mreg != NULL) {
-        MPI_Alloc_mem(size, MPI_INFO_NULL, &new_bufs[i]);
+        new_bufs[i] = ARMCII_Scratch_get(size);
         ARMCII_Assert(new_bufs[i] != NULL);
 
         ARMCI_Copy(orig_bufs[i], new_bufs[i], size);
@@ -76,11 +77,11 @@ void ARMCII_Buf_finish_read_vec(void **orig_bufs, void **new_bufs, int count, in
 
     for (i = 0; i < count; i++) {
       if (orig_bufs[i] != new_bufs[i]) {
-        MPI_Free_mem(new_bufs[i]);
+        ARMCII_Scratch_put(new_bufs[i]);
       }
     }
 
-    free(new_bufs);
+    ARMCII_Scratch_put(new_bufs);
   }
 }
 
@@ -103,7 +104,7 @@ int ARMCII_Buf_prepare_acc_vec(void **orig_bufs, void ***new_bufs_ptr, int count
   void **new_bufs;
   int i, scaled, num_moved = 0;
   
-  new_bufs = malloc(count*sizeof(void*));
+  new_bufs = ARMCII_Scratch_get(count*sizeof(void*));
   ARMCII_Assert(new_bufs != NULL);
 
   scaled = ARMCII_Buf_acc_is_scaled(datatype, scale);
@@ -116,7 +117,7 @@ int ARMCII_Buf_prepare_acc_vec(void **orig_bufs, void ***new_bufs_ptr, int count
       mreg = gmr_lookup(orig_bufs[i], ARMCI_GROUP_WORLD.rank);
 
     if (scaled) {
-      MPI_Alloc_mem(size, MPI_INFO_NULL, &new_bufs[i]);
+      new_bufs[i] = ARMCII_Scratch_get(size);
       ARMCII_Assert(new_bufs[i] != NULL);
 
       ARMCII_Buf_acc_scale(orig_bufs[i], new_bufs[i], size, datatype, scale);
@@ -128,7 +129,7 @@ int ARMCII_Buf_prepare_acc_vec(void **orig_bufs, void ***new_bufs_ptr, int count
     if (mreg != NULL) {
       // If the buffer wasn't copied, we should copy it into a private buffer
       if (new_bufs[i] == orig_bufs[i]) {
-        MPI_Alloc_mem(size, MPI_INFO_NULL, &new_bufs[i]);
+        new_bufs[i] = ARMCII_Scratch_get(size);
         ARMCII_Assert(new_bufs[i] != NULL);
 
         ARMCI_Copy(orig_bufs[i], new_bufs[i], size);
@@ -159,11 +160,11 @@ void ARMCII_Buf_finish_acc_vec(void **orig_bufs, void **new_bufs, int count, int
 
   for (i = 0; i < count; i++) {
     if (orig_bufs[i] != new_bufs[i]) {
-      MPI_Free_mem(new_bufs[i]);
+      ARMCII_Scratch_put(new_bufs[i]);
     }
   }
 
-  free(new_bufs);
+  ARMCII_Scratch_put(new_bufs);
 }
 
 
@@ -181,7 +182,7 @@ int ARMCII_Buf_prepare_write_vec(void **orig_bufs, void ***new_bufs_ptr, int cou
   int num_moved = 0;
 
   if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_NOGUARD) {
-    void **new_bufs = malloc(count*sizeof(void*));
+    void **new_bufs = ARMCII_Scratch_get(count*sizeof(void*));
     int i;
 
     for (i = 0; i < count; i++)
@@ -193,7 +194,7 @@ int ARMCII_Buf_prepare_write_vec(void **orig_bufs, void ***new_bufs_ptr, int cou
       gmr_t *mreg = gmr_lookup(orig_bufs[i], ARMCI_GROUP_WORLD.rank);
 
       if (mreg != NULL) {
-        MPI_Alloc_mem(size, MPI_INFO_NULL, &new_bufs[i]);
+        new_bufs[i] = ARMCII_Scratch_get(size);
         ARMCII_Assert(new_bufs[i] != NULL);
         num_moved++;
       } else {
@@ -231,11 +232,11 @@ void ARMCII_Buf_finish_write_vec(void **orig_bufs, void **new_bufs, int count, i
         ARMCI_Copy(new_bufs[i], orig_bufs[i], size);
         // gmr_put(mreg, new_bufs[i], orig_bufs[i], size, ARMCI_GROUP_WORLD.rank);
 
-        MPI_Free_mem(new_bufs[i]);
+        ARMCII_Scratch_put(new_bufs[i]);
       }
     }
 
-    free(new_bufs);
+    ARMCII_Scratch_put(new_bufs);
   }
 }
 
@@ -289,130 +290,75 @@ int ARMCII_Buf_acc_is_scaled(int datatype, void *scale) {
 }
 
 
-/** Prepare a set of buffers for use with an accumulate operation.  The
-  * returned set of buffers is guaranteed to be in private space and scaled.
-  * Copies will be made if needed, the result should be completed by finish.
+/** Size in bytes of each ARMCI accumulate type, indexed by type.
+  */
+static const int ARMCII_Acc_type_sizes[] = {
+  sizeof(int), sizeof(long), sizeof(float), sizeof(double), 2*sizeof(float), 2*sizeof(double)
+};
+
+
+/** Scale a buffer for use with an accumulate operation.
   *
-  * @param[in]  buf       Original set of buffers.
-  * @param[in]  count     Number of entries in the buffer list.
-  * @param[in]  size      The size of the buffers (all are of the same size).
+  * @param[in]  buf_in    Input buffer.
+  * @param[out] buf_out   Output buffer.
+  * @param[in]  size      The size of the buffers in bytes.
   * @param[in]  datatype  The type of the buffer.
-  * @param[in]  scale     Scaling constant to apply to each buffer.
-  * @return               Pointer to the new buffer or buf
+  * @param[in]  scale     Scaling constant to apply to the buffer.
   */
 void ARMCII_Buf_acc_scale(void *buf_in, void *buf_out, int size, int datatype, void *scale) {
-  int   j, nelem;
-  int   type_size = -1;
+  int type_size;
 
-  switch (datatype) {
-    case ARMCI_ACC_INT:
-      MPI_Type_size(MPI_INT, &type_size);
-      nelem= size/type_size;
+  if (datatype < ARMCI_ACC_INT || datatype > ARMCI_ACC_DCP)
+    ARMCII_Error("unknown data type (%d)", datatype);
 
-      {
-        int *src_i = (int*) buf_in;
-        int *scl_i = (int*) buf_out;
-        const int s = *((int*) scale);
+  type_size = ARMCII_Acc_type_sizes[datatype];
 
-        for (j = 0; j < nelem; j++)
-          scl_i[j] = src_i[j]*s;
-      }
-      break;
-
-    case ARMCI_ACC_LNG:
-      MPI_Type_size(MPI_LONG, &type_size);
-      nelem= size/type_size;
-
-      {
-        long *src_l = (long*) buf_in;
-        long *scl_l = (long*) buf_out;
-        const long s = *((long*) scale);
-
-        for (j = 0; j < nelem; j++)
-          scl_l[j] = src_l[j]*s;
-      }
-      break;
+  ARMCII_Assert_msg(size % type_size == 0, 
+      "Transfer size is not a multiple of the datatype size");
 
-    case ARMCI_ACC_FLT:
-      MPI_Type_size(MPI_FLOAT, &type_size);
-      nelem= size/type_size;
+  ARMCII_Acc_scale(buf_in, buf_out, size/type_size, datatype, scale);
+}
 
-      {
-        float *src_f = (float*) buf_in;
-        float *scl_f = (float*) buf_out;
-        const float s = *((float*) scale);
 
-        for (j = 0; j < nelem; j++)
-          scl_f[j] = src_f[j]*s;
-      }
-      break;
+/** Scale a strided buffer into a contiguous buffer for use with an accumulate
+  * operation.  Each contiguous block is scaled directly into its place in the
+  * output, without building an I/O vector first.
+  *
+  * @param[in]  src_ptr        Strided input buffer.
+  * @param[in]  src_stride_ar  Array of stride_levels stride lengths in bytes.
+  * @param[in]  count          Array of stride_levels+1 counts; count[0] is in bytes.
+  * @param[in]  stride_levels  Number of levels of striding.
+  * @param[out] buf_out        Contiguous output buffer.
+  * @param[in]  datatype       The type of the buffer.
+  * @param[in]  scale          Scaling constant to apply to the buffer.
+  */
+void ARMCII_Buf_acc_scale_strided(void *src_ptr, int src_stride_ar[], int count[], int stride_levels,
+                                  void *buf_out, int datatype, void *scale) {
+  int          idx[stride_levels+1];
+  int          i;
+  armci_size_t nblocks;
+  uint8_t     *out = buf_out;
 
-    case ARMCI_ACC_DBL:
-      MPI_Type_size(MPI_DOUBLE, &type_size);
-      nelem= size/type_size;
+  for (i = 0; i <= stride_levels; i++)
+    idx[i] = 0;
 
-      {
-        double *src_d = (double*) buf_in;
-        double *scl_d = (double*) buf_out;
-        const double s = *((double*) scale);
+  for (i = 1, nblocks = 1; i <= stride_levels; i++)
+    nblocks *= count[i];
 
-        for (j = 0; j < nelem; j++)
-          scl_d[j] = src_d[j]*s;
-      }
-      break;
+  while (nblocks-- > 0) {
+    uint8_t *src = src_ptr;
 
-    case ARMCI_ACC_CPL:
-      MPI_Type_size(MPI_FLOAT, &type_size);
-      nelem= size/type_size;
-
-      {
-        float *src_fc = (float*) buf_in;
-        float *scl_fc = (float*) buf_out;
-        const float s_r = ((float*)scale)[0];
-        const float s_c = ((float*)scale)[1];
-
-        for (j = 0; j < nelem; j += 2) {
-          // Complex multiplication: (a + bi)*(c + di)
-          const float src_fc_j   = src_fc[j];
-          const float src_fc_j_1 = src_fc[j+1];
-          /*
-          scl_fc[j]   = src_fc[j]*s_r   - src_fc[j+1]*s_c;
-          scl_fc[j+1] = src_fc[j+1]*s_r + src_fc[j]*s_c;
-          */
-          scl_fc[j]   = src_fc_j*s_r   - src_fc_j_1*s_c;
-          scl_fc[j+1] = src_fc_j_1*s_r + src_fc_j*s_c;
-        }
-      }
-      break;
+    for (i = 1; i <= stride_levels; i++)
+      src += (ptrdiff_t) idx[i]*src_stride_ar[i-1];
 
-    case ARMCI_ACC_DCP:
-      MPI_Type_size(MPI_DOUBLE, &type_size);
-      nelem= size/type_size;
-
-      {
-        double *src_dc = (double*) buf_in;
-        double *scl_dc = (double*) buf_out;
-        const double s_r = ((double*)scale)[0];
-        const double s_c = ((double*)scale)[1];
-
-        for (j = 0; j < nelem; j += 2) {
-          // Complex multiplication: (a + bi)*(c + di)
-          const double src_dc_j   = src_dc[j];
-          const double src_dc_j_1 = src_dc[j+1];
-          /*
-          scl_dc[j]   = src_dc[j]*s_r   - src_dc[j+1]*s_c;
-          scl_dc[j+1] = src_dc[j+1]*s_r + src_dc[j]*s_c;
-          */
-          scl_dc[j]   = src_dc_j*s_r   - src_dc_j_1*s_c;
-          scl_dc[j+1] = src_dc_j_1*s_r + src_dc_j*s_c;
-        }
-      }
-      break;
+    ARMCII_Buf_acc_scale(src, out, count[0], datatype, scale);
+    out += count[0];
 
-    default:
-      ARMCII_Error("unknown data type (%d)", datatype);
+    /* Advance the block index, lowest strided dimension first */
+    for (i = 1; i <= stride_levels; i++) {
+      if (++idx[i] < count[i])
+        break;
+      idx[i] = 0;
+    }
   }
-
-  ARMCII_Assert_msg(size % type_size == 0, 
-      "Transfer size is not a multiple of the datatype size");
 }
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <armci.h>
+#include <armci_internals.h>
+#include <debug.h>
+
+/** Cache of committed strided datatypes.  Strided operations in DIRECT mode
+  * describe both sides of the transfer with MPI datatypes; applications tend
+  * to repeat the same patch shapes, so committed types are kept in a bounded
+  * cache keyed by the strided description and evicted in least recently used
+  * order.
+  *
+  * Evicting a type frees it, which is safe while operations using it are
+  * still pending.  A caller needs the types it obtained for one operation to
+  * stay valid until the operation is issued, so the cache holds at least two
+  * entries and an entry is never evicted by the lookup right after its own.
+  */
+
+#define DTYPE_CACHE_NBUCKETS 256
+
+typedef struct dtype_entry_s {
+  int                   stride_levels;
+  int                   dense;        /* Packed buffer; the key holds only counts   */
+  MPI_Datatype          old_type;
+  MPI_Datatype          type;         /* Committed datatype                         */
+  unsigned              hash;
+  struct dtype_entry_s *lru_prev;     /* Most recently used first                   */
+  struct dtype_entry_s *lru_next;
+  struct dtype_entry_s *bucket_next;
+  int                   key[1];       /* Strides followed by counts (variable size) */
+} dtype_entry_t;
+
+static dtype_entry_t *dtype_buckets[DTYPE_CACHE_NBUCKETS];
+static dtype_entry_t *dtype_lru_head = NULL;
+static dtype_entry_t *dtype_lru_tail = NULL;
+static int            dtype_count    = 0;
+static unsigned long  dtype_hits     = 0;
+static unsigned long  dtype_misses   = 0;
+
+
+/** Hash a strided description (FNV-1a over the key words).
+  */
+static unsigned dtype_hash(int stride_ar[], int count[], int stride_levels, MPI_Datatype old_type) {
+  unsigned h = 2166136261u;
+  int i;
+
+#define DTYPE_HASH_WORD(w_) do { h ^= (unsigned) (w_); h *= 16777619u; } while (0)
+  DTYPE_HASH_WORD(stride_levels);
+  DTYPE_HASH_WORD(stride_ar == NULL);
+  DTYPE_HASH_WORD((size_t) old_type);
+
+  for (i = 0; stride_ar != NULL && i < stride_levels; i++)
+    DTYPE_HASH_WORD(stride_ar[i]);
+  for (i = 0; i < stride_levels+1; i++)
+    DTYPE_HASH_WORD(count[i]);
+#undef DTYPE_HASH_WORD
+
+  return h;
+}
+
+
+static int dtype_match(dtype_entry_t *e, unsigned hash, int stride_ar[], int count[],
+                       int stride_levels, MPI_Datatype old_type) {
+  return    e->hash == hash && e->stride_levels == stride_levels && e->old_type == old_type
+         && e->dense == (stride_ar == NULL)
+         && (stride_ar == NULL || memcmp(e->key, stride_ar, sizeof(int)*stride_levels) == 0)
+         && memcmp(e->key + stride_levels, count, sizeof(int)*(stride_levels+1)) == 0;
+}
+
+
+/** Build a datatype for a packed buffer holding a patch with the given counts.
+  * Nesting one contiguous type per level keeps every count within an int even
+  * when the buffer is larger than 2 GiB.
+  */
+static void dtype_build_dense(int count[], int stride_levels, MPI_Datatype old_type, MPI_Datatype *new_type) {
+  MPI_Datatype type, tmp;
+  int i, old_type_size;
+
+  MPI_Type_size(old_type, &old_type_size);
+  ARMCII_Assert((count[0] % old_type_size) == 0);
+
+  MPI_Type_contiguous(count[0]/old_type_size, old_type, &type);
+
+  for (i = 1; i < stride_levels+1; i++) {
+    if (count[i] == 1) continue;
+    MPI_Type_contiguous(count[i], type, &tmp);
+    MPI_Type_free(&type);
+    type = tmp;
+  }
+
+  *new_type = type;
+}
+
+
+/** Build a committed datatype for a cache key.
+  */
+static void dtype_build(int stride_ar[], int count[], int stride_levels,
+                        MPI_Datatype old_type, MPI_Datatype *new_type) {
+  if (stride_ar == NULL)
+    dtype_build_dense(count, stride_levels, old_type, new_type);
+  else
+    ARMCII_Strided_to_dtype(stride_ar, count, stride_levels, old_type, new_type);
+
+  MPI_Type_commit(new_type);
+}
+
+
+static void dtype_lru_unlink(dtype_entry_t *e) {
+  if (e->lru_prev) e->lru_prev->lru_next = e->lru_next;
+  else             dtype_lru_head        = e->lru_next;
+  if (e->lru_next) e->lru_next->lru_prev = e->lru_prev;
+  else             dtype_lru_tail        = e->lru_prev;
+}
+
+
+static void dtype_lru_push(dtype_entry_t *e) {
+  e->lru_prev = NULL;
+  e->lru_next = dtype_lru_head;
+  if (dtype_lru_head) dtype_lru_head->lru_prev = e;
+  else                dtype_lru_tail           = e;
+  dtype_lru_head = e;
+}
+
+
+/** Remove an entry from the cache and free its datatype.
+  */
+static void dtype_evict(dtype_entry_t *e) {
+  dtype_entry_t **prev = &dtype_buckets[e->hash % DTYPE_CACHE_NBUCKETS];
+
+  while (*prev != e)
+    prev = &(*prev)->bucket_next;
+
+  *prev = e->bucket_next;
+  dtype_lru_unlink(e);
+
+  MPI_Type_free(&e->type);
+  free(e);
+  dtype_count--;
+}
+
+
+/** Look up or build the datatype for a cache key.  A NULL stride_ar selects
+  * a packed buffer.
+  */
+static void dtype_lookup(int stride_ar[], int count[], int stride_levels,
+                         MPI_Datatype old_type, MPI_Datatype *new_type) {
+  unsigned       hash;
+  dtype_entry_t *e;
+
+  if (ARMCII_GLOBAL_STATE.strided_dtype_cache == 0) {
+    dtype_build(stride_ar, count, stride_levels, old_type, new_type);
+    return;
+  }
+
+  hash = dtype_hash(stride_ar, count, stride_levels, old_type);
+
+  for (e = dtype_buckets[hash % DTYPE_CACHE_NBUCKETS]; e != NULL; e = e->bucket_next) {
+    if (dtype_match(e, hash, stride_ar, count, stride_levels, old_type)) {
+      dtype_hits++;
+
+      if (e != dtype_lru_head) {
+        dtype_lru_unlink(e);
+        dtype_lru_push(e);
+      }
+
+      *new_type = e->type;
+      return;
+    }
+  }
+
+  dtype_misses++;
+
+  if (dtype_count >= ARMCII_GLOBAL_STATE.strided_dtype_cache)
+    dtype_evict(dtype_lru_tail);
+
+  e = malloc(sizeof(dtype_entry_t) + sizeof(int)*(2*stride_levels));
+  ARMCII_Assert(e != NULL);
+
+  e->stride_levels = stride_levels;
+  e->dense         = (stride_ar == NULL);
+  e->old_type      = old_type;
+  e->hash          = hash;
+  if (stride_ar != NULL)
+    memcpy(e->key, stride_ar, sizeof(int)*stride_levels);
+  memcpy(e->key + stride_levels, count, sizeof(int)*(stride_levels+1));
+
+  dtype_build(stride_ar, count, stride_levels, old_type, &e->type);
+
+  e->bucket_next = dtype_buckets[hash % DTYPE_CACHE_NBUCKETS];
+  dtype_buckets[hash % DTYPE_CACHE_NBUCKETS] = e;
+  dtype_lru_push(e);
+  dtype_count++;
+
+  *new_type = e->type;
+}
+
+
+/** Get a committed datatype describing a strided buffer.  The type must be
+  * released with ARMCII_Strided_dtype_done once the operation using it has
+  * been issued.
+  *
+  * @param[in]  stride_ar     Array of stride_levels stride lengths in bytes
+  * @param[in]  count         Array of stride_levels+1 counts; count[0] is in bytes
+  * @param[in]  stride_levels Number of levels of striding
+  * @param[in]  old_type      Element type
+  * @param[out] new_type      Committed datatype
+  */
+void ARMCII_Strided_dtype(int stride_ar[], int count[], int stride_levels,
+                          MPI_Datatype old_type, MPI_Datatype *new_type) {
+  ARMCII_Assert(stride_ar != NULL || stride_levels == 0);
+  dtype_lookup(stride_levels > 0 ? stride_ar : NULL, count, stride_levels, old_type, new_type);
+}
+
+
+/** Get a committed datatype describing a contiguous buffer.  The type must be
+  * released with ARMCII_Strided_dtype_done.
+  *
+  * @param[in]  bytes    Size of the buffer in bytes
+  * @param[in]  old_type Element type
+  * @param[out] new_type Committed datatype
+  */
+void ARMCII_Contig_dtype(int bytes, MPI_Datatype old_type, MPI_Datatype *new_type) {
+  dtype_lookup(NULL, &bytes, 0, old_type, new_type);
+}
+
+
+/** Get a committed datatype describing a packed buffer that holds a strided
+  * patch, such as the buffer filled by armci_write_strided.  Unlike
+  * ARMCII_Contig_dtype, the size of the buffer may exceed INT_MAX.  The type
+  * must be released with ARMCII_Strided_dtype_done.
+  *
+  * @param[in]  count         Array of stride_levels+1 counts; count[0] is in bytes
+  * @param[in]  stride_levels Number of levels of striding
+  * @param[in]  old_type      Element type
+  * @param[out] new_type      Committed datatype
+  */
+void ARMCII_Dense_dtype(int count[], int stride_levels, MPI_Datatype old_type, MPI_Datatype *new_type) {
+  dtype_lookup(NULL, count, stride_levels, old_type, new_type);
+}
+
+
+/** Release a datatype from ARMCII_Strided_dtype.  Cached types stay alive;
+  * types built with the cache disabled are freed.
+  *
+  * @param[inout] type Datatype to release
+  */
+void ARMCII_Strided_dtype_done(MPI_Datatype *type) {
+  if (ARMCII_GLOBAL_STATE.strided_dtype_cache == 0)
+    MPI_Type_free(type);
+  else
+    *type = MPI_DATATYPE_NULL;
+}
+
+
+/** Free all cached datatypes (called by finalize).
+  */
+void ARMCII_Strided_dtype_free_all(void) {
+  if (ARMCII_GLOBAL_STATE.verbose && ARMCI_GROUP_WORLD.rank == 0 && dtype_hits + dtype_misses > 0)
+    printf("ARMCI-MPI strided datatype cache: %lu hits, %lu misses\n", dtype_hits, dtype_misses);
+
+  while (dtype_lru_tail != NULL)
+    dtype_evict(dtype_lru_tail);
+
+  dtype_hits   = 0;
+  dtype_misses = 0;
+}
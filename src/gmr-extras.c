@@ -70,7 +70,10 @@ int gmr_get_accumulate_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype
   ARMCII_Assert_msg(disp >= 0 && disp < mreg->slices[proc].size, "Invalid remote address");
   ARMCII_Assert_msg(disp + dst_count*extent <= mreg->slices[proc].size, "Transfer is out of range");
 
-  MPI_Get_accumulate(src, src_count, src_type, out, out_count, out_type, grp_proc, (MPI_Aint) disp, dst_count, dst_type, op, mreg->window);
+  gmr_acc_issued(mreg);
+  gmr_set_dirty(mreg, grp_proc);
+
+  MPI_Get_accumulate(src, src_count, src_type, out, out_count, out_type, grp_proc, gmr_target_disp(mreg, disp, proc), dst_count, dst_type, op, mreg->window);
 
   return 0;
 }
@@ -103,7 +106,10 @@ int gmr_fetch_and_op(gmr_t *mreg, void *src, void *out, void *dst,
   ARMCII_Assert_msg(disp >= 0 && disp < mreg->slices[proc].size, "Invalid remote address");
   ARMCII_Assert_msg(disp <= mreg->slices[proc].size, "Transfer is out of range");
 
-  MPI_Fetch_and_op(src, out, type, grp_proc, (MPI_Aint) disp, op, mreg->window);
+  gmr_acc_issued(mreg);
+  gmr_set_dirty(mreg, grp_proc);
+
+  MPI_Fetch_and_op(src, out, type, grp_proc, gmr_target_disp(mreg, disp, proc), op, mreg->window);
 
   return 0;
 }
@@ -141,7 +147,63 @@ int gmr_unlockall(gmr_t *mreg) {
   return 0;
 }
 
-/** Flush a memory region for local or remote completion.
+/** If non-NULL, operations record their (window, target) pair here.
+  */
+gmr_target_set_t *gmr_target_set = NULL;
+
+/** Remove a window from the dirty window list.
+  */
+static void gmr_dirty_unlink(gmr_t *owner) {
+  if (owner->dirty_prev == NULL) {
+    ARMCII_Assert(gmr_dirty_list == owner);
+    gmr_dirty_list = owner->dirty_next;
+  } else {
+    owner->dirty_prev->dirty_next = owner->dirty_next;
+  }
+
+  if (owner->dirty_next != NULL)
+    owner->dirty_next->dirty_prev = owner->dirty_prev;
+
+  owner->dirty_prev = NULL;
+  owner->dirty_next = NULL;
+}
+
+/** Mark all targets of a window clean, e.g. before it is freed.
+  *
+  * @param[in] owner        Region that owns the window
+  */
+void gmr_clear_dirty(gmr_t *owner) {
+  if (owner->ndirty == 0)
+    return;
+
+  memset(owner->dirty, 0, owner->group.size);
+  owner->ndirty = 0;
+  gmr_dirty_unlink(owner);
+}
+
+/** Flush a window at one target if operations are outstanding there.
+  *
+  * @param[in] owner        Region that owns the window
+  * @param[in] grp_proc     Rank of the target in the window's group
+  * @param[in] local_only   Only flush the operation locally.
+  */
+static void gmr_flush_target(gmr_t *owner, int grp_proc, int local_only) {
+  if (!owner->dirty[grp_proc])
+    return;
+
+  if (!local_only || ARMCII_GLOBAL_STATE.end_to_end_flush) {
+    MPI_Win_flush(grp_proc, owner->window);
+
+    owner->dirty[grp_proc] = 0;
+    if (--owner->ndirty == 0)
+      gmr_dirty_unlink(owner);
+  } else {
+    MPI_Win_flush_local(grp_proc, owner->window);
+  }
+}
+
+/** Flush a memory region for local or remote completion.  Targets with no
+  * operations issued since the last remote flush are skipped.
   *
   * @param[in] mreg         Memory region
   * @param[in] proc         Absolute process id of the target
@@ -156,15 +218,178 @@ int gmr_flush(gmr_t *mreg, int proc, int local_only) {
   ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
   ARMCII_Assert_msg(grp_proc < mreg->group.size, "grp_proc exceeds group size!");
 
-  if (!local_only || ARMCII_GLOBAL_STATE.end_to_end_flush) {
-    MPI_Win_flush(grp_proc, mreg->window);
-  } else {
-    MPI_Win_flush_local(grp_proc, mreg->window);
+  gmr_flush_target((mreg->parent != NULL) ? mreg->parent : mreg, grp_proc, local_only);
+
+  return 0;
+}
+
+/** Add a (window, target) pair to a target set.
+  *
+  * @param[in] set          Target set
+  * @param[in] owner        Region that owns the window
+  * @param[in] grp_proc     Rank of the target in the window's group
+  */
+void gmr_target_set_add(gmr_target_set_t *set, gmr_t *owner, int grp_proc) {
+  int i;
+
+  for (i = set->count - 1; i >= 0; i--)
+    if (set->pairs[i].owner == owner && set->pairs[i].grp_proc == grp_proc)
+      return;
+
+  if (set->count == set->capacity) {
+    set->capacity = (set->capacity > 0) ? 2*set->capacity : 8;
+    set->pairs    = realloc(set->pairs, sizeof(struct gmr_target_s)*set->capacity);
+    ARMCII_Assert(set->pairs != NULL);
+  }
+
+  set->pairs[set->count].owner    = owner;
+  set->pairs[set->count].grp_proc = grp_proc;
+  set->count++;
+}
+
+/** Allocate a request in a target set for a request-based operation.
+  *
+  * @param[in] set          Target set
+  * @return                 Request to pass to the operation
+  */
+MPI_Request *gmr_target_set_request(gmr_target_set_t *set) {
+  if (set->nrequests == set->req_capacity) {
+    set->req_capacity = (set->req_capacity > 0) ? 2*set->req_capacity : 8;
+    set->requests     = realloc(set->requests, sizeof(MPI_Request)*set->req_capacity);
+    ARMCII_Assert(set->requests != NULL);
+  }
+
+  return &set->requests[set->nrequests++];
+}
+
+/** Record that an operation is about to be issued on a region's window to a
+  * target.  When a handle is being recorded in request-based mode, the
+  * operation completes through the returned request instead of a flush.
+  *
+  * @param[in] mreg         Memory region
+  * @param[in] grp_proc     Rank of the target in the region's group
+  * @return                 Request for the operation or NULL to issue it
+  *                         without a request
+  */
+MPI_Request *gmr_set_dirty_request(gmr_t *mreg, int grp_proc) {
+  if (gmr_target_set != NULL && ARMCII_GLOBAL_STATE.use_rma_requests) {
+    gmr_mark_dirty((mreg->parent != NULL) ? mreg->parent : mreg, grp_proc);
+    return gmr_target_set_request(gmr_target_set);
   }
 
+  gmr_set_dirty(mreg, grp_proc);
+  return NULL;
+}
+
+/** Change the put/get atomicity policy of a region for this process.  Put and
+  * get operations issued under the old policy are completed first, so that
+  * they cannot be reordered with operations issued under the new one.  AUTO
+  * follows the decision of the last barrier (see gmr_barrier).
+  *
+  * @param[in] mreg         Memory region
+  * @param[in] atomicity    New policy (ARMCIX_ATOMICITY_*)
+  */
+void gmr_set_atomicity(gmr_t *mreg, int atomicity) {
+  const int rma_atomic =    atomicity == ARMCIX_ATOMICITY_ON
+                         || (atomicity == ARMCIX_ATOMICITY_AUTO && !mreg->acc_free);
+
+  if (rma_atomic != mreg->rma_atomic)
+    gmr_flushall(mreg, 0);
+
+  mreg->atomicity  = atomicity;
+  mreg->rma_atomic = rma_atomic;
+}
+
+/** Complete the operations in a target set and empty the set.  Requests are
+  * waited on and the (window, target) pairs are flushed.  Pairs whose window
+  * is no longer dirty have nothing outstanding and are skipped.
+  *
+  * @param[in] set          Target set
+  * @param[in] local_only   Only flush the operations locally.
+  * @return                 0 on success, non-zero on failure
+  */
+int gmr_complete_set(gmr_target_set_t *set, int local_only) {
+  int i;
+
+  if (set->nrequests > 0) {
+    MPI_Waitall(set->nrequests, set->requests, MPI_STATUSES_IGNORE);
+    set->nrequests = 0;
+  }
+
+  for (i = 0; i < set->count; i++)
+    gmr_flush_target(set->pairs[i].owner, set->pairs[i].grp_proc, local_only);
+
+  set->count = 0;
+
   return 0;
 }
 
+/** Test whether the operations in a target set are complete.  Pairs without
+  * requests can only be completed by a flush, so they are flushed locally once
+  * the requests are done.
+  *
+  * @param[in] set          Target set
+  * @return                 Nonzero if all operations are complete, in which
+  *                         case the set is emptied
+  */
+int gmr_test_set(gmr_target_set_t *set) {
+  int flag = 1;
+
+  if (set->nrequests > 0)
+    MPI_Testall(set->nrequests, set->requests, &flag, MPI_STATUSES_IGNORE);
+
+  if (flag)
+    gmr_complete_set(set, 1);
+
+  return flag;
+}
+
+/** Forget the operations in a target set without completing them.  Requests
+  * must still be freed, so they are waited on.
+  *
+  * @param[in] set          Target set
+  */
+void gmr_clear_set(gmr_target_set_t *set) {
+  if (set->nrequests > 0) {
+    MPI_Waitall(set->nrequests, set->requests, MPI_STATUSES_IGNORE);
+    set->nrequests = 0;
+  }
+
+  set->count = 0;
+}
+
+/** Remove the pairs of a window from a target set, e.g. before the window is
+  * freed.  Freeing the window completes its operations.
+  *
+  * @param[in] set          Target set
+  * @param[in] owner        Region that owns the window
+  */
+void gmr_purge_set(gmr_target_set_t *set, gmr_t *owner) {
+  int i, j;
+
+  for (i = j = 0; i < set->count; i++)
+    if (set->pairs[i].owner != owner)
+      set->pairs[j++] = set->pairs[i];
+
+  set->count = j;
+}
+
+/** Free the memory held by a target set.
+  *
+  * @param[in] set          Target set
+  */
+void gmr_free_set(gmr_target_set_t *set) {
+  gmr_clear_set(set);
+
+  free(set->pairs);
+  free(set->requests);
+
+  set->pairs        = NULL;
+  set->capacity     = 0;
+  set->requests     = NULL;
+  set->req_capacity = 0;
+}
+
 /** Flush a memory region for remote completion to all targets.
   *
   * @param[in] mreg         Memory region
@@ -172,12 +397,17 @@ int gmr_flush(gmr_t *mreg, int proc, int local_only) {
   */
 int gmr_flushall(gmr_t *mreg, int local_only) {
   int grp_me   = ARMCII_Translate_absolute_to_group(&mreg->group, ARMCI_GROUP_WORLD.rank);
+  gmr_t *owner = (mreg->parent != NULL) ? mreg->parent : mreg;
 
   ARMCII_Assert(grp_me >= 0);
   ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
 
+  if (owner->ndirty == 0)
+    return 0;
+
   if (!local_only || ARMCII_GLOBAL_STATE.end_to_end_flush) {
     MPI_Win_flush_all(mreg->window);
+    gmr_clear_dirty(owner);
   } else {
     MPI_Win_flush_local_all(mreg->window);
   }
@@ -185,6 +415,57 @@ int gmr_flushall(gmr_t *mreg, int local_only) {
   return 0;
 }
 
+/** Synchronize the world group like MPI_Barrier and decide the put/get
+  * atomicity of AUTO regions allocated on it.  A region on which no process
+  * has accumulated uses plain puts and gets from now on; once any process
+  * has, it stays atomic on every process.  The accumulated flags of all such
+  * regions are combined in one allreduce, which also serves as the barrier.
+  * Regions of other groups are not decided here, and stay atomic under AUTO.
+  * Collective on the world group; operations on the regions must have been
+  * completed.
+  */
+void gmr_barrier(void) {
+  gmr_t  *win, *mreg, **regs;
+  int    *acc, n = 0, i;
+
+  /* Slabs and dynamic windows hold their regions as children */
+  for (win = gmr_list; win != NULL; win = win->next) {
+    if (win->group.comm != ARMCI_GROUP_WORLD.comm) continue;
+    if (win->slab == NULL && !win->dynamic) n++;
+    for (mreg = win->children; mreg != NULL; mreg = mreg->next) n++;
+  }
+
+  if (n == 0) {
+    MPI_Barrier(ARMCI_GROUP_WORLD.comm);
+    return;
+  }
+
+  regs = malloc((sizeof(gmr_t*) + sizeof(int))*n);
+  ARMCII_Assert(regs != NULL);
+  acc = (int*) (regs + n);
+
+  for (win = gmr_list, i = 0; win != NULL; win = win->next) {
+    if (win->group.comm != ARMCI_GROUP_WORLD.comm) continue;
+    if (win->slab == NULL && !win->dynamic) regs[i++] = win;
+    for (mreg = win->children; mreg != NULL; mreg = mreg->next) regs[i++] = mreg;
+  }
+
+  for (i = 0; i < n; i++)
+    acc[i] = regs[i]->accumulated;
+
+  MPI_Allreduce(MPI_IN_PLACE, acc, n, MPI_INT, MPI_LOR, ARMCI_GROUP_WORLD.comm);
+
+  for (i = 0; i < n; i++) {
+    regs[i]->accumulated = acc[i];
+    regs[i]->acc_free    = !acc[i];
+
+    if (regs[i]->atomicity == ARMCIX_ATOMICITY_AUTO)
+      regs[i]->rma_atomic = acc[i];
+  }
+
+  free(regs);
+}
+
 /** Sync memory region so that public and private windows are the same.
   *
   * @param[in] mreg         Memory region
@@ -198,6 +479,9 @@ int gmr_sync(gmr_t *mreg) {
 
   MPI_Win_sync(mreg->window);
 
+  if (mreg->shm_window != MPI_WIN_NULL && mreg->shm_window != mreg->window)
+    MPI_Win_sync(mreg->shm_window);
+
   return 0;
 }
 
@@ -4,6 +4,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 #include <string.h>
 #include <mpi.h>
 
@@ -17,15 +18,186 @@
   */
 gmr_t *gmr_list = NULL;
 
+/** Windows with operations issued since their last remote flush.
+  */
+gmr_t *gmr_dirty_list = NULL;
 
-/** Create a distributed shared memory region. Collective on ARMCI group.
+/** Slab allocations are aligned to this many bytes.
+  */
+#define GMR_SLAB_ALIGN 64
+
+static void gmr_destroy_window(gmr_t *mreg);
+
+/** Per-process index of shared memory regions.  Entry i holds the regions
+  * that have a nonzero slice on world rank i, sorted by base address, so that
+  * lookups can use a binary search rather than walking gmr_list.
+  */
+typedef struct {
+  uint8_t    *base;
+  gmr_size_t  size;
+  gmr_t      *mreg;
+} gmr_index_entry_t;
+
+typedef struct {
+  gmr_index_entry_t *entries;
+  int                count;
+  int                capacity;
+} gmr_index_t;
+
+static gmr_index_t *gmr_index        = NULL;
+static int          gmr_index_nproc  = 0;
+
+/** Region returned by the most recent successful lookup.  Consecutive
+  * operations frequently target the same allocation.
+  */
+static gmr_t       *gmr_lookup_cache = NULL;
+
+
+/** Find the position of the first entry in an index list whose base is
+  * greater than the given address.
+  */
+static int gmr_index_upper_bound(const gmr_index_t *idx, const uint8_t *ptr) {
+  int lo = 0, hi = idx->count;
+
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+
+    if (idx->entries[mid].base <= ptr)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+
+  return lo;
+}
+
+
+/** Add a region's nonzero slices to the lookup index.
+  */
+static void gmr_index_insert(gmr_t *mreg) {
+  int proc;
+
+  if (gmr_index == NULL) {
+    gmr_index_nproc = mreg->nslices;
+    gmr_index       = calloc(gmr_index_nproc, sizeof(gmr_index_t));
+    ARMCII_Assert(gmr_index != NULL);
+  }
+
+  ARMCII_Assert(mreg->nslices == gmr_index_nproc);
+
+  for (proc = 0; proc < mreg->nslices; proc++) {
+    gmr_index_t *idx = &gmr_index[proc];
+    int          pos;
+
+    if (mreg->slices[proc].size == 0)
+      continue;
+
+    if (idx->count == idx->capacity) {
+      idx->capacity = (idx->capacity == 0) ? 4 : 2*idx->capacity;
+      idx->entries  = realloc(idx->entries, idx->capacity*sizeof(gmr_index_entry_t));
+      ARMCII_Assert(idx->entries != NULL);
+    }
+
+    pos = gmr_index_upper_bound(idx, mreg->slices[proc].base);
+    memmove(&idx->entries[pos+1], &idx->entries[pos], (idx->count-pos)*sizeof(gmr_index_entry_t));
+
+    idx->entries[pos].base = mreg->slices[proc].base;
+    idx->entries[pos].size = mreg->slices[proc].size;
+    idx->entries[pos].mreg = mreg;
+    idx->count++;
+  }
+}
+
+
+/** Remove a region's slices from the lookup index.
+  */
+static void gmr_index_remove(gmr_t *mreg) {
+  int proc;
+
+  if (gmr_lookup_cache == mreg)
+    gmr_lookup_cache = NULL;
+
+  for (proc = 0; proc < mreg->nslices; proc++) {
+    gmr_index_t *idx = &gmr_index[proc];
+    int          pos;
+
+    if (mreg->slices[proc].size == 0)
+      continue;
+
+    pos = gmr_index_upper_bound(idx, mreg->slices[proc].base) - 1;
+    ARMCII_Assert(pos >= 0 && idx->entries[pos].mreg == mreg);
+
+    memmove(&idx->entries[pos], &idx->entries[pos+1], (idx->count-pos-1)*sizeof(gmr_index_entry_t));
+    idx->count--;
+  }
+}
+
+
+/** Free the lookup index.
+  */
+static void gmr_index_free(void) {
+  int proc;
+
+  if (gmr_index == NULL)
+    return;
+
+  for (proc = 0; proc < gmr_index_nproc; proc++)
+    free(gmr_index[proc].entries);
+
+  free(gmr_index);
+  gmr_index        = NULL;
+  gmr_index_nproc  = 0;
+  gmr_lookup_cache = NULL;
+}
+
+
+/** Record the local addresses of the slices that live in a region's
+  * node-level shared memory window.
+  *
+  * @param[in] mreg Memory region with a shared memory window
+  */
+static void gmr_shm_query(gmr_t *mreg) {
+  int       i, shm_nproc;
+  MPI_Group world_group, shm_group;
+
+  mreg->shm_bases = calloc(mreg->nslices, sizeof(void*));
+  ARMCII_Assert(mreg->shm_bases != NULL);
+
+  MPI_Comm_group(ARMCI_GROUP_WORLD.comm, &world_group);
+  MPI_Win_get_group(mreg->shm_window, &shm_group);
+  MPI_Group_size(shm_group, &shm_nproc);
+
+  for (i = 0; i < shm_nproc; i++) {
+    MPI_Aint size;
+    int      disp_unit, world_rank;
+    void    *base;
+
+    MPI_Win_shared_query(mreg->shm_window, i, &size, &disp_unit, &base);
+    MPI_Group_translate_ranks(shm_group, 1, &i, world_group, &world_rank);
+
+    if (size > 0)
+      mreg->shm_bases[world_rank] = base;
+  }
+
+  MPI_Group_free(&shm_group);
+  MPI_Group_free(&world_group);
+
+  /* Load/store accesses are synchronized with MPI_Win_sync, which must be
+   * called inside a passive target epoch. */
+  if (mreg->shm_window != mreg->window)
+    MPI_Win_lock_all(MPI_MODE_NOCHECK, mreg->shm_window);
+}
+
+
+/** Create a memory region backed by its own MPI window and append it to
+  * gmr_list.  Collective on ARMCI group.
   *
   * @param[in]  local_size Size of the local slice of the memory region.
   * @param[out] base_ptrs  Array of base pointers for each process in group.
   * @param[in]  group      Group on which to perform allocation.
   * @return                Pointer to the memory region object.
   */
-gmr_t *gmr_create(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
+static gmr_t *gmr_create_window(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
   int           i;
   gmr_size_t    aggregate_size;
   int           alloc_me, alloc_nproc;
@@ -59,6 +231,18 @@ gmr_t *gmr_create(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
   mreg->nslices        = world_nproc;
   mreg->prev           = NULL;
   mreg->next           = NULL;
+  mreg->shm_window     = MPI_WIN_NULL;
+  mreg->shm_bases      = NULL;
+  mreg->parent         = NULL;
+  mreg->children       = NULL;
+  mreg->offset         = 0;
+  mreg->slab           = NULL;
+  mreg->dynamic        = 0;
+  mreg->dirty          = calloc(alloc_nproc, sizeof(uint8_t));
+  mreg->ndirty         = 0;
+  mreg->dirty_prev     = NULL;
+  mreg->dirty_next     = NULL;
+  ARMCII_Assert(mreg->dirty != NULL);
 
   /* Allocate my slice of the GMR */
   alloc_slices[alloc_me].size = local_size;
@@ -71,7 +255,36 @@ gmr_t *gmr_create(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
       alloc_shm_info = MPI_INFO_NULL;
   }
 
-  if (ARMCII_GLOBAL_STATE.use_win_allocate) {
+  if (ARMCII_GLOBAL_STATE.use_win_allocate_shared) {
+      MPI_Comm node_comm;
+      int      node_nproc;
+
+      /* Allocate the slice in a shared memory window on this node and expose
+       * it to the whole group through a second window.  Processes on the
+       * same node can then access each other's slices directly. */
+      if (alloc_shm_info == MPI_INFO_NULL)
+          MPI_Info_create(&alloc_shm_info);
+      MPI_Info_set(alloc_shm_info, "alloc_shared_noncontig", "true");
+
+      MPI_Comm_split_type(group->comm, MPI_COMM_TYPE_SHARED, 0, MPI_INFO_NULL, &node_comm);
+      MPI_Comm_size(node_comm, &node_nproc);
+      MPI_Win_allocate_shared( (MPI_Aint) local_size, 1, alloc_shm_info, node_comm, &(alloc_slices[alloc_me].base), &mreg->shm_window);
+      MPI_Comm_free(&node_comm);
+
+      if (local_size == 0) {
+        alloc_slices[alloc_me].base = NULL;
+      } else {
+        ARMCII_Assert(alloc_slices[alloc_me].base != NULL);
+      }
+
+      /* If the whole group is on this node, the shared memory window (whose
+       * ranks are ordered as in the group) is also used for RMA. */
+      if (node_nproc == alloc_nproc)
+        mreg->window = mreg->shm_window;
+      else
+        MPI_Win_create(alloc_slices[alloc_me].base, (MPI_Aint) local_size, 1, MPI_INFO_NULL, group->comm, &mreg->window);
+
+  } else if (ARMCII_GLOBAL_STATE.use_win_allocate) {
 
       /* give hint to CASPER to avoid extra work for lock permission */
       if (alloc_shm_info == MPI_INFO_NULL)
@@ -118,7 +331,13 @@ gmr_t *gmr_create(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
 
   /* Everyone asked for 0 bytes, return a NULL vector */
   if (aggregate_size == 0) {
+    if (mreg->shm_window != MPI_WIN_NULL && mreg->shm_window != mreg->window)
+      MPI_Win_free(&mreg->shm_window);
+
+    MPI_Win_free(&mreg->window);
+
     free(alloc_slices);
+    free(mreg->dirty);
     free(mreg->slices);
     free(mreg);
 
@@ -152,6 +371,9 @@ gmr_t *gmr_create(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
   MPI_Win_lock_all((ARMCII_GLOBAL_STATE.rma_nocheck) ? MPI_MODE_NOCHECK : 0,
                    mreg->window);
 
+  if (mreg->shm_window != MPI_WIN_NULL)
+    gmr_shm_query(mreg);
+
   {
     int unified;
     void    *attr_ptr;
@@ -207,6 +429,633 @@ gmr_t *gmr_create(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
 }
 
 
+/** Add a region to the list of regions that live in its parent's window.
+  */
+static void gmr_add_child(gmr_t *parent, gmr_t *mreg) {
+  mreg->prev = NULL;
+  mreg->next = parent->children;
+
+  if (mreg->next != NULL)
+    mreg->next->prev = mreg;
+
+  parent->children = mreg;
+}
+
+
+/** Remove a region from its parent's list of children.
+  */
+static void gmr_remove_child(gmr_t *parent, gmr_t *mreg) {
+  if (mreg->prev == NULL) {
+    ARMCII_Assert(parent->children == mreg);
+    parent->children = mreg->next;
+  } else {
+    mreg->prev->next = mreg->next;
+  }
+
+  if (mreg->next != NULL)
+    mreg->next->prev = mreg->prev;
+}
+
+
+/** Reserve space in a slab.  The result depends only on the slab's state, so
+  * every process in the slab's group makes the same choice.
+  *
+  * @param[in]  slab   Slab state
+  * @param[in]  size   Number of bytes to reserve in each process's slice
+  * @param[out] offset Offset of the reserved space within the slab
+  * @return            Nonzero if the space was reserved
+  */
+static int gmr_slab_reserve(gmr_slab_t *slab, gmr_size_t size, gmr_size_t *offset) {
+  gmr_extent_t **ext;
+
+  for (ext = &slab->free_list; *ext != NULL; ext = &(*ext)->next) {
+    if ((*ext)->size >= size) {
+      *offset         = (*ext)->offset;
+      (*ext)->offset += size;
+      (*ext)->size   -= size;
+
+      if ((*ext)->size == 0) {
+        gmr_extent_t *used = *ext;
+        *ext = used->next;
+        free(used);
+      }
+
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+
+/** Return space to a slab, merging it with neighboring free extents.
+  *
+  * @param[in] slab   Slab state
+  * @param[in] offset Offset of the space within the slab
+  * @param[in] size   Number of bytes to release
+  */
+static void gmr_slab_release(gmr_slab_t *slab, gmr_size_t offset, gmr_size_t size) {
+  gmr_extent_t *prev = NULL, *next = slab->free_list;
+
+  while (next != NULL && next->offset < offset) {
+    prev = next;
+    next = next->next;
+  }
+
+  if (prev != NULL && prev->offset + prev->size == offset) {
+    prev->size += size;
+  } else {
+    gmr_extent_t *ext = malloc(sizeof(gmr_extent_t));
+    ARMCII_Assert(ext != NULL);
+
+    ext->offset = offset;
+    ext->size   = size;
+    ext->next   = next;
+
+    if (prev == NULL)
+      slab->free_list = ext;
+    else
+      prev->next = ext;
+
+    prev = ext;
+  }
+
+  if (next != NULL && prev->offset + prev->size == next->offset) {
+    prev->size += next->size;
+    prev->next  = next->next;
+    free(next);
+  }
+}
+
+
+/** Space reserved in a slab for a suballocated region: the largest slice,
+  * rounded up to the slab alignment.
+  */
+static gmr_size_t gmr_slab_extent(gmr_t *mreg) {
+  gmr_size_t max_size = 0;
+  int        i;
+
+  for (i = 0; i < mreg->nslices; i++)
+    if (mreg->slices[i].size > max_size)
+      max_size = mreg->slices[i].size;
+
+  return (max_size + GMR_SLAB_ALIGN - 1) / GMR_SLAB_ALIGN * GMR_SLAB_ALIGN;
+}
+
+
+/** Carve a region out of a slab window if it is small enough.  Collective on
+  * ARMCI group.  Instead of creating a window, this costs one MPI_Allgather of
+  * the local sizes.
+  *
+  * @param[in]  local_size Size of the local slice of the memory region.
+  * @param[out] base_ptrs  Array of base pointers for each process in group.
+  * @param[in]  group      Group on which to perform allocation.
+  * @return                Pointer to the memory region object or NULL if the
+  *                        allocation is not eligible for a slab.
+  */
+static gmr_t *gmr_create_from_slab(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
+  int           i, alloc_nproc, world_nproc;
+  int          *alloc_ranks, *world_ranks;
+  gmr_size_t   *sizes, max_size, extent, offset = 0;
+  MPI_Group     world_group, alloc_group;
+  gmr_t        *slab, *mreg;
+
+  MPI_Comm_size(group->comm, &alloc_nproc);
+  MPI_Comm_size(ARMCI_GROUP_WORLD.comm, &world_nproc);
+
+  sizes = malloc(sizeof(gmr_size_t)*alloc_nproc);
+  ARMCII_Assert(sizes != NULL);
+
+  MPI_Allgather(&local_size, sizeof(gmr_size_t), MPI_BYTE,
+                 sizes, sizeof(gmr_size_t), MPI_BYTE, group->comm);
+
+  for (i = 0, max_size = 0; i < alloc_nproc; i++)
+    if (sizes[i] > max_size)
+      max_size = sizes[i];
+
+  /* Zero-size and large allocations are handled by gmr_create_window */
+  if (max_size == 0 || max_size > ARMCII_GLOBAL_STATE.slab_threshold) {
+    free(sizes);
+    return NULL;
+  }
+
+  extent = (max_size + GMR_SLAB_ALIGN - 1) / GMR_SLAB_ALIGN * GMR_SLAB_ALIGN;
+
+  /* Find a slab on this group with enough free space.  Slabs on a given group
+   * were created collectively, so all of its processes see them in the same
+   * order and make the same choice. */
+  for (slab = gmr_list; slab != NULL; slab = slab->next) {
+    if (   slab->slab != NULL && slab->group.comm == group->comm
+        && gmr_slab_reserve(slab->slab, extent, &offset))
+      break;
+  }
+
+  if (slab == NULL) {
+    gmr_size_t slab_size = ARMCII_GLOBAL_STATE.slab_size;
+    void     **slab_ptrs;
+
+    if (slab_size < extent)
+      slab_size = extent;
+
+    slab_ptrs = malloc(sizeof(void*)*alloc_nproc);
+    ARMCII_Assert(slab_ptrs != NULL);
+
+    slab = gmr_create_window(slab_size, slab_ptrs, group);
+    ARMCII_Assert(slab != NULL);
+    free(slab_ptrs);
+
+    slab->slab = malloc(sizeof(gmr_slab_t));
+    ARMCII_Assert(slab->slab != NULL);
+
+    slab->slab->free_list = NULL;
+    gmr_slab_release(slab->slab, 0, slab_size);
+
+    i = gmr_slab_reserve(slab->slab, extent, &offset);
+    ARMCII_Assert(i);
+  }
+
+  ARMCII_Dbg_print(DEBUG_CAT_MEM_REGION, "carving %ld bytes at offset %ld from slab %p\n",
+                   (long) extent, (long) offset, (void*) slab);
+
+  mreg = malloc(sizeof(gmr_t));
+  ARMCII_Assert(mreg != NULL);
+
+  mreg->slices = calloc(world_nproc, sizeof(gmr_slice_t));
+  ARMCII_Assert(mreg->slices != NULL);
+
+  mreg->window         = slab->window;
+  mreg->group          = *group;
+  mreg->nslices        = world_nproc;
+  mreg->shm_window     = slab->shm_window;
+  mreg->shm_bases      = NULL;
+  mreg->parent         = slab;
+  mreg->children       = NULL;
+  mreg->offset         = offset;
+  mreg->slab           = NULL;
+  mreg->dynamic        = 0;
+  mreg->dirty          = NULL;
+  mreg->ndirty         = 0;
+  mreg->dirty_prev     = NULL;
+  mreg->dirty_next     = NULL;
+
+  /* The region's slices are at the same offset in every slice of the slab */
+  alloc_ranks = malloc(sizeof(int)*alloc_nproc);
+  world_ranks = malloc(sizeof(int)*alloc_nproc);
+  ARMCII_Assert(alloc_ranks != NULL && world_ranks != NULL);
+
+  for (i = 0; i < alloc_nproc; i++)
+    alloc_ranks[i] = i;
+
+  MPI_Comm_group(ARMCI_GROUP_WORLD.comm, &world_group);
+  MPI_Comm_group(group->comm, &alloc_group);
+  MPI_Group_translate_ranks(alloc_group, alloc_nproc, alloc_ranks, world_group, world_ranks);
+  MPI_Group_free(&world_group);
+  MPI_Group_free(&alloc_group);
+
+  for (i = 0; i < alloc_nproc; i++) {
+    gmr_slice_t *slice = &mreg->slices[world_ranks[i]];
+
+    if (sizes[i] > 0) {
+      slice->base = ((uint8_t*) slab->slices[world_ranks[i]].base) + offset;
+      slice->size = sizes[i];
+    }
+
+    base_ptrs[i] = slice->base;
+  }
+
+  free(alloc_ranks);
+  free(world_ranks);
+  free(sizes);
+
+  /* Debugging: Zero out shared memory if enabled */
+  if (ARMCII_GLOBAL_STATE.debug_alloc && local_size > 0) {
+    ARMCII_Bzero(mreg->slices[ARMCI_GROUP_WORLD.rank].base, local_size);
+  }
+
+  gmr_add_child(slab, mreg);
+
+  return mreg;
+}
+
+
+/** Find a dynamic window for a group with room for another allocation, or
+  * create a new one.  Collective on ARMCI group.  Dynamic windows on a group
+  * and the regions attached to them are created collectively, so all of its
+  * processes pick the same window.
+  *
+  * MPI libraries may limit the number of segments attached to a window, and
+  * may not recover from exceeding it.  Every process attaches at most one
+  * segment per region, so the number of regions bounds the local count.
+  *
+  * @param[in] group Group on which to perform allocation.
+  * @return          Region that owns the dynamic window, or NULL if the MPI
+  *                  library could not create one.
+  */
+static gmr_t *gmr_dynamic_window(ARMCI_Group *group) {
+  gmr_t          *win, *mreg;
+  MPI_Info        win_info;
+  MPI_Errhandler  errhandler;
+  int             world_nproc, err, failed;
+
+  for (win = gmr_list; win != NULL; win = win->next) {
+    int nattached = 0;
+
+    if (!win->dynamic || win->group.comm != group->comm)
+      continue;
+
+    if (ARMCII_GLOBAL_STATE.dynamic_window_attach_limit <= 0)
+      return win;
+
+    for (mreg = win->children; mreg != NULL; mreg = mreg->next)
+      nattached++;
+
+    if (nattached < ARMCII_GLOBAL_STATE.dynamic_window_attach_limit)
+      return win;
+  }
+
+  MPI_Comm_size(ARMCI_GROUP_WORLD.comm, &world_nproc);
+
+  win = malloc(sizeof(gmr_t));
+  ARMCII_Assert(win != NULL);
+
+  /* give hint to CASPER to avoid extra work for lock permission */
+  MPI_Info_create(&win_info);
+  MPI_Info_set(win_info, "epochs_used", "lockall");
+
+  /* Some MPI libraries cannot create windows on every communicator, in which
+   * case the caller falls back to a window per allocation */
+  MPI_Comm_get_errhandler(group->comm, &errhandler);
+  MPI_Comm_set_errhandler(group->comm, MPI_ERRORS_RETURN);
+  err = MPI_Win_create_dynamic(win_info, group->comm, &win->window);
+  MPI_Comm_set_errhandler(group->comm, errhandler);
+  MPI_Errhandler_free(&errhandler);
+  MPI_Info_free(&win_info);
+
+  failed = (err != MPI_SUCCESS);
+  MPI_Allreduce(MPI_IN_PLACE, &failed, 1, MPI_INT, MPI_LOR, group->comm);
+
+  if (failed) {
+    if (err == MPI_SUCCESS)
+      MPI_Win_free(&win->window);
+    free(win);
+
+    ARMCII_Dbg_print(DEBUG_CAT_MEM_REGION, "could not create a dynamic window\n");
+    return NULL;
+  }
+
+  /* The owner has no memory of its own; its slices stay empty */
+  win->slices = calloc(world_nproc, sizeof(gmr_slice_t));
+  ARMCII_Assert(win->slices != NULL);
+
+  win->group          = *group;
+  win->nslices        = world_nproc;
+  win->prev           = NULL;
+  win->next           = NULL;
+  win->shm_window     = MPI_WIN_NULL;
+  win->shm_bases      = NULL;
+  win->parent         = NULL;
+  win->children       = NULL;
+  win->offset         = 0;
+  win->slab           = NULL;
+  win->dynamic        = 1;
+  win->dirty          = calloc(group->size, sizeof(uint8_t));
+  win->ndirty         = 0;
+  win->dirty_prev     = NULL;
+  win->dirty_next     = NULL;
+  ARMCII_Assert(win->dirty != NULL);
+
+  MPI_Win_lock_all((ARMCII_GLOBAL_STATE.rma_nocheck) ? MPI_MODE_NOCHECK : 0,
+                   win->window);
+
+  ARMCII_Dbg_print(DEBUG_CAT_MEM_REGION, "created dynamic window %p\n", (void*) win);
+
+  /* Append the window onto the region list */
+  if (gmr_list == NULL) {
+    gmr_list = win;
+
+  } else {
+    gmr_t *parent = gmr_list;
+
+    while (parent->next != NULL)
+      parent = parent->next;
+
+    parent->next = win;
+    win->prev    = parent;
+  }
+
+  return win;
+}
+
+
+/** Create a region by attaching memory to one of the group's dynamic windows.
+  * Collective on ARMCI group.  Instead of creating a window, this costs one
+  * MPI_Allgather of the local slices.
+  *
+  * @param[in]  local_size Size of the local slice of the memory region.
+  * @param[out] base_ptrs  Array of base pointers for each process in group.
+  * @param[in]  group      Group on which to perform allocation.
+  * @return                Pointer to the memory region object, or NULL if the
+  *                        allocation is empty or no dynamic window could be
+  *                        created.
+  */
+static gmr_t *gmr_create_dynamic(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
+  int           i, alloc_me, alloc_nproc, world_nproc;
+  int          *alloc_ranks, *world_ranks;
+  gmr_size_t    aggregate_size;
+  MPI_Group     world_group, alloc_group;
+  gmr_slice_t  *alloc_slices;
+  gmr_t        *win, *mreg;
+
+  MPI_Comm_rank(group->comm, &alloc_me);
+  MPI_Comm_size(group->comm, &alloc_nproc);
+  MPI_Comm_size(ARMCI_GROUP_WORLD.comm, &world_nproc);
+
+  win = gmr_dynamic_window(group);
+
+  if (win == NULL)
+    return NULL;
+
+  alloc_slices = malloc(sizeof(gmr_slice_t)*alloc_nproc);
+  ARMCII_Assert(alloc_slices != NULL);
+
+  /* Allocate my slice of the GMR and expose it through the window */
+  alloc_slices[alloc_me].size = local_size;
+
+  if (local_size == 0) {
+    alloc_slices[alloc_me].base = NULL;
+  } else {
+    MPI_Alloc_mem(local_size, MPI_INFO_NULL, &(alloc_slices[alloc_me].base));
+    ARMCII_Assert(alloc_slices[alloc_me].base != NULL);
+    MPI_Win_attach(win->window, alloc_slices[alloc_me].base, (MPI_Aint) local_size);
+  }
+
+  /* Debugging: Zero out shared memory if enabled */
+  if (ARMCII_GLOBAL_STATE.debug_alloc && local_size > 0) {
+    ARMCII_Bzero(alloc_slices[alloc_me].base, local_size);
+  }
+
+  MPI_Allgather(MPI_IN_PLACE, sizeof(gmr_slice_t), MPI_BYTE,
+                alloc_slices, sizeof(gmr_slice_t), MPI_BYTE, group->comm);
+
+  for (i = aggregate_size = 0; i < alloc_nproc; i++)
+    aggregate_size += alloc_slices[i].size;
+
+  /* Everyone asked for 0 bytes, gmr_create_window returns a NULL vector */
+  if (aggregate_size == 0) {
+    free(alloc_slices);
+
+    for (i = 0; i < alloc_nproc; i++)
+      base_ptrs[i] = NULL;
+
+    if (win->children == NULL && win->group.comm != ARMCI_GROUP_WORLD.comm)
+      gmr_destroy_window(win);
+
+    return NULL;
+  }
+
+  mreg = malloc(sizeof(gmr_t));
+  ARMCII_Assert(mreg != NULL);
+
+  mreg->slices = calloc(world_nproc, sizeof(gmr_slice_t));
+  ARMCII_Assert(mreg->slices != NULL);
+
+  mreg->window         = win->window;
+  mreg->group          = *group;
+  mreg->nslices        = world_nproc;
+  mreg->shm_window     = MPI_WIN_NULL;
+  mreg->shm_bases      = NULL;
+  mreg->parent         = win;
+  mreg->children       = NULL;
+  mreg->offset         = 0;
+  mreg->slab           = NULL;
+  mreg->dynamic        = 1;
+  mreg->dirty          = NULL;
+  mreg->ndirty         = 0;
+  mreg->dirty_prev     = NULL;
+  mreg->dirty_next     = NULL;
+
+  /* Shovel the slices into the array indexed by global rank */
+  alloc_ranks = malloc(sizeof(int)*alloc_nproc);
+  world_ranks = malloc(sizeof(int)*alloc_nproc);
+  ARMCII_Assert(alloc_ranks != NULL && world_ranks != NULL);
+
+  for (i = 0; i < alloc_nproc; i++)
+    alloc_ranks[i] = i;
+
+  MPI_Comm_group(ARMCI_GROUP_WORLD.comm, &world_group);
+  MPI_Comm_group(group->comm, &alloc_group);
+  MPI_Group_translate_ranks(alloc_group, alloc_nproc, alloc_ranks, world_group, world_ranks);
+  MPI_Group_free(&world_group);
+  MPI_Group_free(&alloc_group);
+
+  for (i = 0; i < alloc_nproc; i++) {
+    mreg->slices[world_ranks[i]] = alloc_slices[i];
+    base_ptrs[i] = alloc_slices[i].base;
+  }
+
+  free(alloc_ranks);
+  free(world_ranks);
+  free(alloc_slices);
+
+  gmr_add_child(win, mreg);
+
+  return mreg;
+}
+
+
+/** Create a distributed shared memory region. Collective on ARMCI group.
+  *
+  * @param[in]  local_size Size of the local slice of the memory region.
+  * @param[out] base_ptrs  Array of base pointers for each process in group.
+  * @param[in]  group      Group on which to perform allocation.
+  * @return                Pointer to the memory region object.
+  */
+gmr_t *gmr_create(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group) {
+  gmr_t *mreg = NULL;
+
+  ARMCII_Assert(local_size >= 0);
+  ARMCII_Assert(group != NULL);
+
+  /* All allocations are attached to a dynamic window, or small allocations
+   * are carved out of a slab */
+  if (ARMCII_GLOBAL_STATE.use_dynamic_window)
+    mreg = gmr_create_dynamic(local_size, base_ptrs, group);
+  else if (ARMCII_GLOBAL_STATE.slab_threshold > 0)
+    mreg = gmr_create_from_slab(local_size, base_ptrs, group);
+
+  if (mreg == NULL)
+    mreg = gmr_create_window(local_size, base_ptrs, group);
+
+  if (mreg != NULL) {
+    /* AUTO regions are atomic until a barrier finds that no process
+     * accumulated on them */
+    mreg->atomicity   = ARMCII_GLOBAL_STATE.rma_atomicity;
+    mreg->rma_atomic  = (mreg->atomicity != ARMCIX_ATOMICITY_OFF);
+    mreg->accumulated = 0;
+    mreg->acc_free    = 0;
+    gmr_index_insert(mreg);
+  }
+
+  return mreg;
+}
+
+
+/** Free a region that owns its window: remove it from gmr_list, free the
+  * window and the memory.  Collective on the region's group.
+  *
+  * @param[in] mreg  Memory region
+  */
+static void gmr_destroy_window(gmr_t *mreg) {
+  int world_me = ARMCI_GROUP_WORLD.rank;
+
+  if (mreg->prev == NULL) {
+    ARMCII_Assert(gmr_list == mreg);
+    gmr_list = mreg->next;
+
+    if (mreg->next != NULL)
+      mreg->next->prev = NULL;
+
+  } else {
+    mreg->prev->next = mreg->next;
+    if (mreg->next != NULL)
+      mreg->next->prev = mreg->prev;
+  }
+
+  ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
+  MPI_Win_unlock_all(mreg->window);
+
+  /* Destroy the window and free all buffers */
+  if (mreg->shm_window != MPI_WIN_NULL && mreg->shm_window != mreg->window) {
+    MPI_Win_unlock_all(mreg->shm_window);
+    MPI_Win_free(&mreg->shm_window);
+  }
+
+  MPI_Win_free(&mreg->window);
+
+  if (mreg->shm_window != MPI_WIN_NULL) {
+    free(mreg->shm_bases);
+  }
+  else if (!ARMCII_GLOBAL_STATE.use_win_allocate) {
+    if (mreg->slices[world_me].base != NULL) {
+      MPI_Free_mem(mreg->slices[world_me].base);
+    }
+  }
+
+  ARMCII_Assert(mreg->children == NULL);
+
+  /* Freeing the window completed any outstanding operations */
+  gmr_clear_dirty(mreg);
+  ARMCII_Hdl_purge(mreg);
+  free(mreg->dirty);
+
+  if (mreg->slab != NULL) {
+    while (mreg->slab->free_list != NULL) {
+      gmr_extent_t *ext = mreg->slab->free_list;
+      mreg->slab->free_list = ext->next;
+      free(ext);
+    }
+
+    free(mreg->slab);
+  }
+
+  free(mreg->slices);
+  free(mreg);
+}
+
+
+/** Return a suballocated region to its slab.  Empty slabs are freed, except on
+  * the world group where allocations are most frequent.  Collective on the
+  * region's group.
+  *
+  * @param[in] mreg  Memory region
+  */
+static void gmr_destroy_from_slab(gmr_t *mreg) {
+  gmr_t *slab = mreg->parent;
+
+  /* Complete operations on the region before its space can be reused */
+  gmr_flushall(slab, 0);
+
+  gmr_remove_child(slab, mreg);
+  gmr_slab_release(slab->slab, mreg->offset, gmr_slab_extent(mreg));
+
+  free(mreg->slices);
+  free(mreg);
+
+  if (slab->children == NULL && slab->group.comm != ARMCI_GROUP_WORLD.comm)
+    gmr_destroy_window(slab);
+}
+
+
+/** Detach a region from its dynamic window and free its memory.  Empty
+  * dynamic windows are freed, except on the world group.  Collective on the
+  * region's group.
+  *
+  * @param[in] mreg  Memory region
+  */
+static void gmr_destroy_dynamic(gmr_t *mreg) {
+  gmr_t *win = mreg->parent;
+  void  *base = mreg->slices[ARMCI_GROUP_WORLD.rank].base;
+
+  /* Complete my operations on the region and wait for everyone else to do the
+   * same before the memory is detached */
+  gmr_flushall(win, 0);
+  MPI_Barrier(mreg->group.comm);
+
+  if (base != NULL) {
+    MPI_Win_detach(win->window, base);
+    MPI_Free_mem(base);
+  }
+
+  gmr_remove_child(win, mreg);
+
+  free(mreg->slices);
+  free(mreg);
+
+  if (win->children == NULL && win->group.comm != ARMCI_GROUP_WORLD.comm)
+    gmr_destroy_window(win);
+}
+
+
 /** Destroy/free a shared memory region.
   *
   * @param[in] ptr   Pointer within range of the segment (e.g. base pointer).
@@ -256,34 +1105,15 @@ void gmr_destroy(gmr_t *mreg, ARMCI_Group *group) {
   /* If it's still not found, the user may have passed the wrong group */
   ARMCII_Assert_msg(mreg != NULL, "Could not locate the desired allocation");
 
-  /* Remove from the list of mem regions */
-  if (mreg->prev == NULL) {
-    ARMCII_Assert(gmr_list == mreg);
-    gmr_list = mreg->next;
-
-    if (mreg->next != NULL)
-      mreg->next->prev = NULL;
-
-  } else {
-    mreg->prev->next = mreg->next;
-    if (mreg->next != NULL)
-      mreg->next->prev = mreg->prev;
-  }
-
-  ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
-  MPI_Win_unlock_all(mreg->window);
-
-  /* Destroy the window and free all buffers */
-  MPI_Win_free(&mreg->window);
-
-  if (!ARMCII_GLOBAL_STATE.use_win_allocate) {
-    if (mreg->slices[world_me].base != NULL) {
-      MPI_Free_mem(mreg->slices[world_me].base);
-    }
-  }
+  /* Remove from the lookup index and free */
+  gmr_index_remove(mreg);
 
-  free(mreg->slices);
-  free(mreg);
+  if (mreg->parent == NULL)
+    gmr_destroy_window(mreg);
+  else if (mreg->parent->dynamic)
+    gmr_destroy_dynamic(mreg);
+  else
+    gmr_destroy_from_slab(mreg);
 }
 
 
@@ -295,10 +1125,23 @@ int gmr_destroy_all(void) {
   int count = 0;
 
   while (gmr_list != NULL) {
-    gmr_destroy(gmr_list, &gmr_list->group);
-    count++;
+    gmr_t *mreg = gmr_list;
+
+    /* Slabs and dynamic windows are internal; only the regions that live in
+     * them were leaked */
+    if (mreg->children != NULL) {
+      gmr_destroy(mreg->children, &mreg->group);
+      count++;
+    } else if (mreg->slab != NULL || mreg->dynamic) {
+      gmr_destroy_window(mreg);
+    } else {
+      gmr_destroy(mreg, &mreg->group);
+      count++;
+    }
   }
 
+  gmr_index_free();
+
   return count;
 }
 
@@ -309,26 +1152,100 @@ int gmr_destroy_all(void) {
   * @return         Pointer to the mem region object.
   */
 gmr_t *gmr_lookup(void *ptr, int proc) {
-  gmr_t *mreg;
+  gmr_t       *mreg = gmr_lookup_cache;
+  gmr_index_t *idx;
+  int          pos;
 
-  mreg = gmr_list;
+  if (mreg != NULL) {
+    const uint8_t   *base, *ptr_b = ptr;
+    gmr_size_t       size;
 
-  while (mreg != NULL) {
     ARMCII_Assert(proc < mreg->nslices);
+    base = mreg->slices[proc].base;
+    size = mreg->slices[proc].size;
 
-    /* Jeff: Why is uint8_t used here?  .base is (void*). */
-    if (proc < mreg->nslices) {
-      const uint8_t   *base = mreg->slices[proc].base;
-      const gmr_size_t size = mreg->slices[proc].size;
+    if (ptr_b >= base && ptr_b < base + size)
+      return mreg;
+  }
 
-      if ((uint8_t*) ptr >= base && (uint8_t*) ptr < base + size)
-        break;
-    }
+  if (gmr_index == NULL)
+    return NULL;
 
-    mreg = mreg->next;
-  }
+  ARMCII_Assert(proc >= 0 && proc < gmr_index_nproc);
 
-  return mreg;
+  /* Find the last region whose base is at or below ptr and check its bounds */
+  idx = &gmr_index[proc];
+  pos = gmr_index_upper_bound(idx, ptr) - 1;
+
+  if (pos < 0 || (uint8_t*) ptr >= idx->entries[pos].base + idx->entries[pos].size)
+    return NULL;
+
+  gmr_lookup_cache = idx->entries[pos].mreg;
+
+  return gmr_lookup_cache;
+}
+
+
+/** Translate a remote address into a local address that can be accessed
+  * directly with load/store, if the target's slice lives in a shared memory
+  * window on this node.  Plain loads and stores are not atomic with respect
+  * to accumulates from other processes, so regions whose puts and gets must
+  * be atomic are never accessed directly.
+  *
+  * @param[in] mreg Memory region
+  * @param[in] ptr  Address in the target's slice
+  * @param[in] proc Absolute process id of the target
+  * @return         Local address of ptr or NULL if the target is off-node or
+  *                 put and get on mreg are atomic.
+  */
+void *gmr_shm_ptr(gmr_t *mreg, void *ptr, int proc) {
+  if (mreg->rma_atomic)
+    return NULL;
+
+  /* Suballocated regions share their parent's window */
+  if (mreg->parent != NULL)
+    mreg = mreg->parent;
+
+  if (mreg->shm_bases == NULL || mreg->shm_bases[proc] == NULL)
+    return NULL;
+
+  return (uint8_t*) mreg->shm_bases[proc] + ((uint8_t*) ptr - (uint8_t*) mreg->slices[proc].base);
+}
+
+
+/** Translate an absolute process id to a rank in the region's group.  Regions
+  * allocated on the world group need no translation.
+  *
+  * @param[in] mreg   Memory region
+  * @param[in] proc   Absolute process id
+  * @return           Rank of proc in the group of mreg
+  */
+static inline int gmr_group_rank(gmr_t *mreg, int proc) {
+  if (mreg->group.comm == ARMCI_GROUP_WORLD.comm)
+    return proc;
+  else
+    return ARMCII_Translate_absolute_to_group(&mreg->group, proc);
+}
+
+
+/** Size of the basic datatypes used by contiguous operations.
+  *
+  * @param[in] type   MPI datatype
+  * @return           Size of the type in bytes, or 0 if it is not a basic type
+  */
+static inline int gmr_basic_type_size(MPI_Datatype type) {
+  if (type == MPI_BYTE)
+    return 1;
+  else if (type == MPI_INT)
+    return sizeof(int);
+  else if (type == MPI_LONG)
+    return sizeof(long);
+  else if (type == MPI_FLOAT)
+    return sizeof(float);
+  else if (type == MPI_DOUBLE)
+    return sizeof(double);
+  else
+    return 0;
 }
 
 
@@ -341,9 +1258,46 @@ gmr_t *gmr_lookup(void *ptr, int proc) {
   * @param[in] proc   Absolute process id of target process
   * @return           0 on success, non-zero on failure
   */
-int gmr_put(gmr_t *mreg, void *src, void *dst, int size, int proc) {
+int gmr_put(gmr_t *mreg, void *src, void *dst, gmr_size_t size, int proc) {
+  int          grp_proc;
+  gmr_size_t   disp;
+  MPI_Request *req;
+
   ARMCII_Assert_msg(src != NULL, "Invalid local address");
-  return gmr_put_typed(mreg, src, size, MPI_BYTE, dst, size, MPI_BYTE, proc);
+  ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
+
+  grp_proc = gmr_group_rank(mreg, proc);
+  ARMCII_Assert(grp_proc >= 0);
+
+  // Calculate displacement from beginning of the window and perform checks
+  disp = (gmr_size_t) ((uint8_t*)dst - (uint8_t*)mreg->slices[proc].base);
+
+  ARMCII_Assert_msg(disp >= 0 && disp < mreg->slices[proc].size, "Invalid remote address");
+  ARMCII_Assert_msg(disp + size <= mreg->slices[proc].size, "Transfer is out of range");
+
+#ifndef GMR_LARGE_COUNT
+  ARMCII_Assert_msg(size <= INT_MAX, "Transfer is too large");
+#endif
+
+  req = gmr_set_dirty_request(mreg, grp_proc);
+
+  if (mreg->rma_atomic) {
+    if (req != NULL)
+      GMR_RMA(MPI_Raccumulate)(src, (gmr_count_t) size, MPI_BYTE, grp_proc, gmr_target_disp(mreg, disp, proc),
+                               (gmr_count_t) size, MPI_BYTE, MPI_REPLACE, mreg->window, req);
+    else
+      GMR_RMA(MPI_Accumulate)(src, (gmr_count_t) size, MPI_BYTE, grp_proc, gmr_target_disp(mreg, disp, proc),
+                              (gmr_count_t) size, MPI_BYTE, MPI_REPLACE, mreg->window);
+  } else {
+    if (req != NULL)
+      GMR_RMA(MPI_Rput)(src, (gmr_count_t) size, MPI_BYTE, grp_proc, gmr_target_disp(mreg, disp, proc),
+                        (gmr_count_t) size, MPI_BYTE, mreg->window, req);
+    else
+      GMR_RMA(MPI_Put)(src, (gmr_count_t) size, MPI_BYTE, grp_proc, gmr_target_disp(mreg, disp, proc),
+                       (gmr_count_t) size, MPI_BYTE, mreg->window);
+  }
+
+  return 0;
 }
 
 
@@ -363,11 +1317,12 @@ int gmr_put(gmr_t *mreg, void *src, void *dst, int size, int proc) {
 int gmr_put_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype src_type,
     void *dst, int dst_count, MPI_Datatype dst_type, int proc) {
 
-  int        grp_proc;
-  gmr_size_t disp;
-  MPI_Aint lb, extent;
+  int          grp_proc;
+  gmr_size_t   disp;
+  MPI_Aint     lb, extent;
+  MPI_Request *req;
 
-  grp_proc = ARMCII_Translate_absolute_to_group(&mreg->group, proc);
+  grp_proc = gmr_group_rank(mreg, proc);
   ARMCII_Assert(grp_proc >= 0);
   ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
 
@@ -382,12 +1337,22 @@ int gmr_put_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype src_type,
   ARMCII_Assert_msg(disp >= 0 && disp < mreg->slices[proc].size, "Invalid remote address");
   ARMCII_Assert_msg(disp + dst_count*extent <= mreg->slices[proc].size, "Transfer is out of range");
 
-  if (ARMCII_GLOBAL_STATE.rma_atomicity) {
+  req = gmr_set_dirty_request(mreg, grp_proc);
+
+  if (mreg->rma_atomic) {
+    if (req != NULL)
+      MPI_Raccumulate(src, src_count, src_type, grp_proc,
+                      gmr_target_disp(mreg, disp, proc), dst_count, dst_type, MPI_REPLACE, mreg->window, req);
+    else
       MPI_Accumulate(src, src_count, src_type, grp_proc,
-                     (MPI_Aint) disp, dst_count, dst_type, MPI_REPLACE, mreg->window);
+                     gmr_target_disp(mreg, disp, proc), dst_count, dst_type, MPI_REPLACE, mreg->window);
   } else {
+    if (req != NULL)
+      MPI_Rput(src, src_count, src_type, grp_proc,
+               gmr_target_disp(mreg, disp, proc), dst_count, dst_type, mreg->window, req);
+    else
       MPI_Put(src, src_count, src_type, grp_proc,
-              (MPI_Aint) disp, dst_count, dst_type, mreg->window);
+              gmr_target_disp(mreg, disp, proc), dst_count, dst_type, mreg->window);
   }
 
   return 0;
@@ -403,9 +1368,48 @@ int gmr_put_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype src_type,
   * @param[in] proc   Absolute process id of target process
   * @return           0 on success, non-zero on failure
   */
-int gmr_get(gmr_t *mreg, void *src, void *dst, int size, int proc) {
+int gmr_get(gmr_t *mreg, void *src, void *dst, gmr_size_t size, int proc) {
+  int          grp_proc;
+  gmr_size_t   disp;
+  MPI_Request *req;
+
   ARMCII_Assert_msg(dst != NULL, "Invalid local address");
-  return gmr_get_typed(mreg, src, size, MPI_BYTE, dst, size, MPI_BYTE, proc);
+  ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
+
+  grp_proc = gmr_group_rank(mreg, proc);
+  ARMCII_Assert(grp_proc >= 0);
+
+  // Calculate displacement from beginning of the window and perform checks
+  disp = (gmr_size_t) ((uint8_t*)src - (uint8_t*)mreg->slices[proc].base);
+
+  ARMCII_Assert_msg(disp >= 0 && disp < mreg->slices[proc].size, "Invalid remote address");
+  ARMCII_Assert_msg(disp + size <= mreg->slices[proc].size, "Transfer is out of range");
+
+#ifndef GMR_LARGE_COUNT
+  ARMCII_Assert_msg(size <= INT_MAX, "Transfer is too large");
+#endif
+
+  req = gmr_set_dirty_request(mreg, grp_proc);
+
+  if (mreg->rma_atomic) {
+    if (req != NULL)
+      GMR_RMA(MPI_Rget_accumulate)(NULL, 0, MPI_BYTE, dst, (gmr_count_t) size, MPI_BYTE, grp_proc,
+                                   gmr_target_disp(mreg, disp, proc), (gmr_count_t) size, MPI_BYTE,
+                                   MPI_NO_OP, mreg->window, req);
+    else
+      GMR_RMA(MPI_Get_accumulate)(NULL, 0, MPI_BYTE, dst, (gmr_count_t) size, MPI_BYTE, grp_proc,
+                                  gmr_target_disp(mreg, disp, proc), (gmr_count_t) size, MPI_BYTE,
+                                  MPI_NO_OP, mreg->window);
+  } else {
+    if (req != NULL)
+      GMR_RMA(MPI_Rget)(dst, (gmr_count_t) size, MPI_BYTE, grp_proc, gmr_target_disp(mreg, disp, proc),
+                        (gmr_count_t) size, MPI_BYTE, mreg->window, req);
+    else
+      GMR_RMA(MPI_Get)(dst, (gmr_count_t) size, MPI_BYTE, grp_proc, gmr_target_disp(mreg, disp, proc),
+                       (gmr_count_t) size, MPI_BYTE, mreg->window);
+  }
+
+  return 0;
 }
 
 
@@ -425,11 +1429,12 @@ int gmr_get(gmr_t *mreg, void *src, void *dst, int size, int proc) {
 int gmr_get_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype src_type,
     void *dst, int dst_count, MPI_Datatype dst_type, int proc) {
 
-  int        grp_proc;
-  gmr_size_t disp;
-  MPI_Aint lb, extent;
+  int          grp_proc;
+  gmr_size_t   disp;
+  MPI_Aint     lb, extent;
+  MPI_Request *req;
 
-  grp_proc = ARMCII_Translate_absolute_to_group(&mreg->group, proc);
+  grp_proc = gmr_group_rank(mreg, proc);
   ARMCII_Assert(grp_proc >= 0);
   ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
 
@@ -444,12 +1449,22 @@ int gmr_get_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype src_type,
   ARMCII_Assert_msg(disp >= 0 && disp < mreg->slices[proc].size, "Invalid remote address");
   ARMCII_Assert_msg(disp + src_count*extent <= mreg->slices[proc].size, "Transfer is out of range");
 
-  if (ARMCII_GLOBAL_STATE.rma_atomicity) {
+  req = gmr_set_dirty_request(mreg, grp_proc);
+
+  if (mreg->rma_atomic) {
+    if (req != NULL)
+      MPI_Rget_accumulate(NULL, 0, MPI_BYTE, dst, dst_count, dst_type, grp_proc,
+                          gmr_target_disp(mreg, disp, proc), src_count, src_type, MPI_NO_OP, mreg->window, req);
+    else
       MPI_Get_accumulate(NULL, 0, MPI_BYTE, dst, dst_count, dst_type, grp_proc,
-                         (MPI_Aint) disp, src_count, src_type, MPI_NO_OP, mreg->window);
+                         gmr_target_disp(mreg, disp, proc), src_count, src_type, MPI_NO_OP, mreg->window);
   } else {
+    if (req != NULL)
+      MPI_Rget(dst, dst_count, dst_type, grp_proc,
+               gmr_target_disp(mreg, disp, proc), src_count, src_type, mreg->window, req);
+    else
       MPI_Get(dst, dst_count, dst_type, grp_proc,
-              (MPI_Aint) disp, src_count, src_type, mreg->window);
+              gmr_target_disp(mreg, disp, proc), src_count, src_type, mreg->window);
   }
 
   return 0;
@@ -466,9 +1481,47 @@ int gmr_get_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype src_type,
   * @param[in] proc     Absolute process id of the target
   * @return             0 on success, non-zero on failure
   */
-int gmr_accumulate(gmr_t *mreg, void *src, void *dst, int count, MPI_Datatype type, int proc) {
+int gmr_accumulate(gmr_t *mreg, void *src, void *dst, gmr_size_t count, MPI_Datatype type, int proc) {
+  int          grp_proc, type_size;
+  gmr_size_t   disp;
+  MPI_Request *req;
+
   ARMCII_Assert_msg(src != NULL, "Invalid local address");
-  return gmr_accumulate_typed(mreg, src, count, type, dst, count, type, proc);
+
+  type_size = gmr_basic_type_size(type);
+
+  /* Derived types need the extent query performed by the typed variant */
+  if (type_size == 0) {
+    ARMCII_Assert_msg(count <= INT_MAX, "Transfer is too large");
+    return gmr_accumulate_typed(mreg, src, count, type, dst, count, type, proc);
+  }
+
+  ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
+
+  grp_proc = gmr_group_rank(mreg, proc);
+  ARMCII_Assert(grp_proc >= 0);
+
+  // Calculate displacement from beginning of the window and perform checks
+  disp = (gmr_size_t) ((uint8_t*)dst - (uint8_t*)mreg->slices[proc].base);
+
+  ARMCII_Assert_msg(disp >= 0 && disp < mreg->slices[proc].size, "Invalid remote address");
+  ARMCII_Assert_msg(disp + (gmr_size_t) count*type_size <= mreg->slices[proc].size, "Transfer is out of range");
+
+#ifndef GMR_LARGE_COUNT
+  ARMCII_Assert_msg(count <= INT_MAX, "Transfer is too large");
+#endif
+
+  gmr_acc_issued(mreg);
+  req = gmr_set_dirty_request(mreg, grp_proc);
+
+  if (req != NULL)
+    GMR_RMA(MPI_Raccumulate)(src, (gmr_count_t) count, type, grp_proc, gmr_target_disp(mreg, disp, proc),
+                             (gmr_count_t) count, type, MPI_SUM, mreg->window, req);
+  else
+    GMR_RMA(MPI_Accumulate)(src, (gmr_count_t) count, type, grp_proc, gmr_target_disp(mreg, disp, proc),
+                            (gmr_count_t) count, type, MPI_SUM, mreg->window);
+
+  return 0;
 }
 
 
@@ -488,11 +1541,12 @@ int gmr_accumulate(gmr_t *mreg, void *src, void *dst, int count, MPI_Datatype ty
 int gmr_accumulate_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype src_type,
     void *dst, int dst_count, MPI_Datatype dst_type, int proc) {
 
-  int        grp_proc;
-  gmr_size_t disp;
-  MPI_Aint lb, extent;
+  int          grp_proc;
+  gmr_size_t   disp;
+  MPI_Aint     lb, extent;
+  MPI_Request *req;
 
-  grp_proc = ARMCII_Translate_absolute_to_group(&mreg->group, proc);
+  grp_proc = gmr_group_rank(mreg, proc);
   ARMCII_Assert(grp_proc >= 0);
   ARMCII_Assert_msg(mreg->window != MPI_WIN_NULL, "A non-null mreg contains a null window.");
 
@@ -507,7 +1561,13 @@ int gmr_accumulate_typed(gmr_t *mreg, void *src, int src_count, MPI_Datatype src
   ARMCII_Assert_msg(disp >= 0 && disp < mreg->slices[proc].size, "Invalid remote address");
   ARMCII_Assert_msg(disp + dst_count*extent <= mreg->slices[proc].size, "Transfer is out of range");
 
-  MPI_Accumulate(src, src_count, src_type, grp_proc, (MPI_Aint) disp, dst_count, dst_type, MPI_SUM, mreg->window);
+  gmr_acc_issued(mreg);
+  req = gmr_set_dirty_request(mreg, grp_proc);
+
+  if (req != NULL)
+    MPI_Raccumulate(src, src_count, src_type, grp_proc, gmr_target_disp(mreg, disp, proc), dst_count, dst_type, MPI_SUM, mreg->window, req);
+  else
+    MPI_Accumulate(src, src_count, src_type, grp_proc, gmr_target_disp(mreg, disp, proc), dst_count, dst_type, MPI_SUM, mreg->window);
 
   return 0;
 }
@@ -12,11 +12,38 @@
 
 typedef armci_size_t gmr_size_t;
 
+/* Contiguous operations use the MPI-4 large-count bindings when they are
+ * available, so that a single operation can move more than INT_MAX elements.
+ * Otherwise counts must fit in an int and larger transfers are split by the
+ * caller. */
+#if MPI_VERSION >= 4
+#  define GMR_LARGE_COUNT
+#  define GMR_RMA(fn_) fn_##_c
+typedef MPI_Count gmr_count_t;
+#else
+#  define GMR_RMA(fn_) fn_
+typedef int gmr_count_t;
+#endif
+
 typedef struct {
   void       *base;
   gmr_size_t  size;
 } gmr_slice_t;
 
+/** Free extent in a slab.  Offsets are the same in every process's slice.
+  */
+typedef struct gmr_extent_s {
+  gmr_size_t              offset;
+  gmr_size_t              size;
+  struct gmr_extent_s    *next;
+} gmr_extent_t;
+
+/** Suballocation state of a slab: a window from which small regions are carved.
+  */
+typedef struct {
+  gmr_extent_t           *free_list;      /* Free extents, sorted by offset                                 */
+} gmr_slab_t;
+
 typedef struct gmr_s {
   MPI_Win                 window;         /* MPI Window for this GMR                                        */
   ARMCI_Group             group;          /* Copy of the ARMCI group on which this GMR was allocated        */
@@ -25,18 +52,112 @@ typedef struct gmr_s {
   struct gmr_s           *next;
   gmr_slice_t            *slices;         /* Array of GMR slices for this allocation                        */
   int                     nslices;
+  MPI_Win                 shm_window;     /* Node-level shared memory window backing the slices, or NULL    */
+  void                  **shm_bases;      /* Local address of each slice on this node, NULL if off-node     */
+
+  struct gmr_s           *parent;         /* Slab or dynamic window this GMR lives in, or NULL if it owns   */
+                                          /* its window                                                     */
+  struct gmr_s           *children;       /* Regions that live in this GMR's window                         */
+  gmr_size_t              offset;         /* Offset of this GMR's slices within the parent's slices         */
+  gmr_slab_t             *slab;           /* Suballocation state if this GMR is a slab, else NULL           */
+  int                     dynamic;        /* Window was created with MPI_Win_create_dynamic                 */
+
+  uint8_t                *dirty;          /* Per group rank, operations issued since the last remote flush  */
+  int                     ndirty;         /* Number of dirty targets                                        */
+  struct gmr_s           *dirty_prev;     /* Linked list pointers for the dirty window list                 */
+  struct gmr_s           *dirty_next;
+
+  int                     atomicity;      /* Put/get atomicity policy of this process (ARMCIX_ATOMICITY_*)  */
+  int                     rma_atomic;     /* Put and get are issued as accumulate operations                */
+  int                     accumulated;    /* This process, or any process as of the last barrier, issued    */
+                                          /* accumulate operations on this region                           */
+  int                     acc_free;       /* No process had accumulated on this region as of the last       */
+                                          /* barrier, and this process has not since                        */
 } gmr_t;
 
+/** Set of (window, target) pairs on which operations were issued, and
+  * requests of request-based operations.  Used to complete only the
+  * operations covered by a nonblocking handle.
+  */
+typedef struct {
+  struct gmr_target_s {
+    gmr_t                *owner;          /* Region that owns the window                                    */
+    int                   grp_proc;       /* Rank of the target in the window's group                       */
+  }                      *pairs;
+  int                     count;
+  int                     capacity;
+
+  MPI_Request            *requests;       /* Requests of operations issued with MPI_Rput and friends        */
+  int                     nrequests;
+  int                     req_capacity;
+} gmr_target_set_t;
+
 extern gmr_t *gmr_list;
+extern gmr_t *gmr_dirty_list;
+extern gmr_target_set_t *gmr_target_set;
+
+void gmr_target_set_add(gmr_target_set_t *set, gmr_t *owner, int grp_proc);
+MPI_Request *gmr_target_set_request(gmr_target_set_t *set);
+
+/** Mark a target of a region's window as having outstanding operations.
+  * Dirty state is kept by the region that owns the window.
+  *
+  * @param[in] owner    Region that owns the window
+  * @param[in] grp_proc Rank of the target in the region's group
+  */
+static inline void gmr_mark_dirty(gmr_t *owner, int grp_proc) {
+  if (owner->dirty[grp_proc])
+    return;
+
+  owner->dirty[grp_proc] = 1;
+
+  if (owner->ndirty++ == 0) {
+    owner->dirty_prev = NULL;
+    owner->dirty_next = gmr_dirty_list;
+
+    if (gmr_dirty_list != NULL)
+      gmr_dirty_list->dirty_prev = owner;
+
+    gmr_dirty_list = owner;
+  }
+}
+
+/** Record that operations were issued on a region's window to a target, and
+  * add the target to the handle being recorded, if any.
+  *
+  * @param[in] mreg     Memory region
+  * @param[in] grp_proc Rank of the target in the region's group
+  */
+static inline void gmr_set_dirty(gmr_t *mreg, int grp_proc) {
+  gmr_t *owner = (mreg->parent != NULL) ? mreg->parent : mreg;
+
+  gmr_mark_dirty(owner, grp_proc);
+
+  if (gmr_target_set != NULL)
+    gmr_target_set_add(gmr_target_set, owner, grp_proc);
+}
+
+MPI_Request *gmr_set_dirty_request(gmr_t *mreg, int grp_proc);
+
+/** Target displacement in a region's window given an offset from the start of
+  * the target's slice.  Dynamic windows are addressed by absolute address.
+  */
+static inline MPI_Aint gmr_target_disp(gmr_t *mreg, gmr_size_t disp, int proc) {
+  if (mreg->dynamic)
+    return (MPI_Aint) mreg->slices[proc].base + (MPI_Aint) disp;
+  else
+    return (MPI_Aint) (mreg->offset + disp);
+}
 
 gmr_t *gmr_create(gmr_size_t local_size, void **base_ptrs, ARMCI_Group *group);
 void   gmr_destroy(gmr_t *mreg, ARMCI_Group *group);
 int    gmr_destroy_all(void);
 gmr_t *gmr_lookup(void *ptr, int proc);
+void  *gmr_shm_ptr(gmr_t *mreg, void *ptr, int proc);
 
-int gmr_get(gmr_t *mreg, void *src, void *dst, int size, int target);
-int gmr_put(gmr_t *mreg, void *src, void *dst, int size, int target);
-int gmr_accumulate(gmr_t *mreg, void *src, void *dst, int count, MPI_Datatype type, int proc);
+int gmr_get(gmr_t *mreg, void *src, void *dst, gmr_size_t size, int target);
+int gmr_put(gmr_t *mreg, void *src, void *dst, gmr_size_t size, int target);
+int gmr_accumulate(gmr_t *mreg, void *src, void *dst, gmr_size_t count, MPI_Datatype type, int proc);
 int gmr_get_accumulate(gmr_t *mreg, void *src, void *out, void *dst, int count, MPI_Datatype type,
     MPI_Op op, int proc);
 int gmr_fetch_and_op(gmr_t *mreg, void *src, void *out, void *dst, MPI_Datatype type, MPI_Op op, int proc);
@@ -56,7 +177,33 @@ int gmr_unlockall(gmr_t *mreg);
 int gmr_flush(gmr_t *mreg, int proc, int local_only);
 int gmr_flushall(gmr_t *mreg, int local_only);
 int gmr_sync(gmr_t *mreg);
+void gmr_set_atomicity(gmr_t *mreg, int atomicity);
+void gmr_barrier(void);
+void gmr_clear_dirty(gmr_t *owner);
+int gmr_complete_set(gmr_target_set_t *set, int local_only);
+int gmr_test_set(gmr_target_set_t *set);
+void gmr_clear_set(gmr_target_set_t *set);
+void gmr_purge_set(gmr_target_set_t *set, gmr_t *owner);
+void gmr_free_set(gmr_target_set_t *set);
 
 void gmr_progress(void);
 
+/** Note that an accumulate operation is about to be issued on a region.  With
+  * the AUTO policy, put and get of this process switch back to accumulate
+  * operations right away, so that they stay ordered with respect to its own
+  * accumulates; earlier puts and gets are completed before the switch.  Other
+  * processes switch at the next barrier (see gmr_barrier).
+  *
+  * @param[in] mreg     Memory region
+  */
+static inline void gmr_acc_issued(gmr_t *mreg) {
+  if (!mreg->rma_atomic && mreg->atomicity == ARMCIX_ATOMICITY_AUTO) {
+    gmr_flushall(mreg, 0);
+    mreg->rma_atomic = 1;
+  }
+
+  mreg->accumulated = 1;
+  mreg->acc_free    = 0;
+}
+
 #endif /* HAVE_GMR_H */
@@ -156,6 +156,15 @@ int PARMCI_Init(void) {
     ARMCII_GLOBAL_STATE.iov_batched_limit = 0;
   }
 
+  ARMCII_GLOBAL_STATE.iov_chunk_len        = ARMCII_Getenv_int("ARMCI_IOV_CHUNK_LEN", 1024);
+
+  if (ARMCII_GLOBAL_STATE.iov_chunk_len < 1) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_IOV_CHUNK_LEN (%d)\n", ARMCII_GLOBAL_STATE.iov_chunk_len);
+    ARMCII_GLOBAL_STATE.iov_chunk_len = 1024;
+  }
+
+  ARMCII_GLOBAL_STATE.iov_coalesce         = ARMCII_Getenv_bool("ARMCI_IOV_COALESCE", 1);
+
 #if defined(OPEN_MPI)
   ARMCII_GLOBAL_STATE.iov_method = ARMCII_IOV_BATCHED;
 #else
@@ -178,6 +187,20 @@ int PARMCI_Init(void) {
       ARMCII_Warning("Ignoring unknown value for ARMCI_IOV_METHOD (%s)\n", var);
   }
 
+  ARMCII_GLOBAL_STATE.iov_auto_min_count   = ARMCII_Getenv_int("ARMCI_IOV_AUTO_MIN_COUNT", 16);
+
+  if (ARMCII_GLOBAL_STATE.iov_auto_min_count < 1) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_IOV_AUTO_MIN_COUNT (%d)\n", ARMCII_GLOBAL_STATE.iov_auto_min_count);
+    ARMCII_GLOBAL_STATE.iov_auto_min_count = 16;
+  }
+
+  ARMCII_GLOBAL_STATE.iov_auto_max_size    = ARMCII_Getenv_int("ARMCI_IOV_AUTO_MAX_SIZE", 4096);
+
+  if (ARMCII_GLOBAL_STATE.iov_auto_max_size < 0) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_IOV_AUTO_MAX_SIZE (%d)\n", ARMCII_GLOBAL_STATE.iov_auto_max_size);
+    ARMCII_GLOBAL_STATE.iov_auto_max_size = 4096;
+  }
+
   /* Check for Strided flags */
 
 
@@ -193,13 +216,36 @@ int PARMCI_Init(void) {
       ARMCII_GLOBAL_STATE.strided_method = ARMCII_STRIDED_IOV;
     else if (strcmp(var, "DIRECT") == 0)
       ARMCII_GLOBAL_STATE.strided_method = ARMCII_STRIDED_DIRECT;
+    else if (strcmp(var, "PACK") == 0)
+      ARMCII_GLOBAL_STATE.strided_method = ARMCII_STRIDED_PACK;
+    else if (strcmp(var, "AUTO") == 0)
+      ARMCII_GLOBAL_STATE.strided_method = ARMCII_STRIDED_AUTO;
     else if (ARMCI_GROUP_WORLD.rank == 0)
       ARMCII_Warning("Ignoring unknown value for ARMCI_STRIDED_METHOD (%s)\n", var);
   }
 
+  /* Cost model of the AUTO strided method */
+
+  ARMCII_Strided_cost_defaults();
+
+  var = ARMCII_Getenv("ARMCI_STRIDED_COST_FILE");
+  if (var != NULL && ARMCII_Strided_cost_load(var) != 0 && ARMCI_GROUP_WORLD.rank == 0)
+    ARMCII_Warning("Unable to read ARMCI_STRIDED_COST_FILE (%s)\n", var);
+
+  /* AUTO only chooses methods that use datatypes where they are known to work */
+
+#if defined(OPEN_MPI)
+  ARMCII_GLOBAL_STATE.strided_auto_dtypes = ARMCII_Getenv_bool("ARMCI_STRIDED_AUTO_DATATYPES", 0);
+#else
+  ARMCII_GLOBAL_STATE.strided_auto_dtypes = ARMCII_Getenv_bool("ARMCI_STRIDED_AUTO_DATATYPES", 1);
+#endif
+
 #ifdef OPEN_MPI
-  if (ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_DIRECT ||
-      ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_DIRECT)
+  if (ARMCI_GROUP_WORLD.rank == 0 &&
+      (ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_DIRECT ||
+       ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_DIRECT ||
+       ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_PACK ||
+       (ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_AUTO && ARMCII_GLOBAL_STATE.strided_auto_dtypes)))
       ARMCII_Warning("MPI Datatypes are broken in RMA in OpenMPI!!!!\n");
 #endif
 
@@ -218,11 +264,130 @@ int PARMCI_Init(void) {
       ARMCII_Warning("Ignoring unknown value for ARMCI_SHR_BUF_METHOD (%s)\n", var);
   }
 
+  /* Accumulate scaling kernels: the widest supported unless narrowed */
+
+  ARMCII_GLOBAL_STATE.scale_isa = ARMCII_Acc_scale_isa_best();
+
+  var = ARMCII_Getenv("ARMCI_SCALE_ISA");
+  if (var != NULL) {
+    enum ARMCII_Scale_isa_e isa = ARMCII_GLOBAL_STATE.scale_isa;
+
+    if (strcmp(var, "SCALAR") == 0)
+      isa = ARMCII_SCALE_SCALAR;
+    else if (strcmp(var, "SSE2") == 0)
+      isa = ARMCII_SCALE_SSE2;
+    else if (strcmp(var, "AVX2") == 0)
+      isa = ARMCII_SCALE_AVX2;
+    else if (strcmp(var, "AVX512") == 0)
+      isa = ARMCII_SCALE_AVX512;
+    else if (strcmp(var, "AUTO") != 0 && ARMCI_GROUP_WORLD.rank == 0)
+      ARMCII_Warning("Ignoring unknown value for ARMCI_SCALE_ISA (%s)\n", var);
+
+    if (isa > ARMCII_GLOBAL_STATE.scale_isa) {
+      if (ARMCI_GROUP_WORLD.rank == 0)
+        ARMCII_Warning("ARMCI_SCALE_ISA %s is not supported; using %s\n", var,
+                       ARMCII_Scale_isa_str[ARMCII_GLOBAL_STATE.scale_isa]);
+    } else {
+      ARMCII_GLOBAL_STATE.scale_isa = isa;
+    }
+  }
+
+  ARMCII_Acc_scale_init(ARMCII_GLOBAL_STATE.scale_isa);
+
   /* Use win_allocate or not, to work around MPI-3 RMA implementation bugs (now fixed) in MPICH. */
 
   int win_alloc_default = 1;
   ARMCII_GLOBAL_STATE.use_win_allocate=ARMCII_Getenv_bool("ARMCI_USE_WIN_ALLOCATE", win_alloc_default);
 
+  /* Allocate from node-level shared memory and use load/store for targets on the same node */
+
+  ARMCII_GLOBAL_STATE.use_win_allocate_shared=ARMCII_Getenv_bool("ARMCI_USE_WIN_ALLOCATE_SHARED", 0);
+
+  /* Attach all allocations on a group to one dynamic window */
+
+  ARMCII_GLOBAL_STATE.use_dynamic_window=ARMCII_Getenv_bool("ARMCI_USE_DYNAMIC_WINDOW", 0);
+  ARMCII_GLOBAL_STATE.dynamic_window_attach_limit=ARMCII_Getenv_int("ARMCI_DYNAMIC_WINDOW_ATTACH_LIMIT", 32);
+
+  if (ARMCII_GLOBAL_STATE.use_dynamic_window && ARMCII_GLOBAL_STATE.use_win_allocate_shared) {
+    if (ARMCI_GROUP_WORLD.rank == 0)
+      ARMCII_Warning("ARMCI_USE_WIN_ALLOCATE_SHARED is ignored when ARMCI_USE_DYNAMIC_WINDOW is enabled\n");
+    ARMCII_GLOBAL_STATE.use_win_allocate_shared = 0;
+  }
+
+  /* Carve small allocations out of larger slab windows */
+
+  ARMCII_GLOBAL_STATE.slab_threshold=ARMCII_Getenv_int("ARMCI_SLAB_THRESHOLD", 0);
+  ARMCII_GLOBAL_STATE.slab_size=ARMCII_Getenv_int("ARMCI_SLAB_SIZE", 1048576);
+
+  if (ARMCII_GLOBAL_STATE.slab_threshold < 0) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_SLAB_THRESHOLD (%d)\n", ARMCII_GLOBAL_STATE.slab_threshold);
+    ARMCII_GLOBAL_STATE.slab_threshold = 0;
+  }
+
+  if (ARMCII_GLOBAL_STATE.slab_size < ARMCII_GLOBAL_STATE.slab_threshold) {
+    ARMCII_Warning("ARMCI_SLAB_SIZE (%d) is smaller than ARMCI_SLAB_THRESHOLD; using %d\n",
+                   ARMCII_GLOBAL_STATE.slab_size, ARMCII_GLOBAL_STATE.slab_threshold);
+    ARMCII_GLOBAL_STATE.slab_size = ARMCII_GLOBAL_STATE.slab_threshold;
+  }
+
+  /* Issue nonblocking operations with MPI_Rput, MPI_Rget and MPI_Raccumulate */
+
+  ARMCII_GLOBAL_STATE.use_rma_requests=ARMCII_Getenv_bool("ARMCI_USE_RMA_REQUESTS", 0);
+
+  /* Cache committed strided datatypes */
+
+  ARMCII_GLOBAL_STATE.strided_dtype_cache=ARMCII_Getenv_int("ARMCI_STRIDED_DTYPE_CACHE", 64);
+
+  if (ARMCII_GLOBAL_STATE.strided_dtype_cache < 0) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_STRIDED_DTYPE_CACHE (%d)\n", ARMCII_GLOBAL_STATE.strided_dtype_cache);
+    ARMCII_GLOBAL_STATE.strided_dtype_cache = 0;
+  }
+
+  /* Both datatypes of one operation must fit in the cache */
+  if (ARMCII_GLOBAL_STATE.strided_dtype_cache == 1)
+    ARMCII_GLOBAL_STATE.strided_dtype_cache = 2;
+
+  /* Reuse scratch buffers for temporary copies */
+
+  ARMCII_GLOBAL_STATE.scratch_pool_limit=ARMCII_Getenv_int("ARMCI_SCRATCH_POOL_LIMIT", 16777216);
+
+  if (ARMCII_GLOBAL_STATE.scratch_pool_limit < 0) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_SCRATCH_POOL_LIMIT (%d)\n", ARMCII_GLOBAL_STATE.scratch_pool_limit);
+    ARMCII_GLOBAL_STATE.scratch_pool_limit = 0;
+  }
+
+  /* Strided pack/unpack engine */
+
+  ARMCII_GLOBAL_STATE.pack_nt_threshold=ARMCII_Getenv_int("ARMCI_PACK_NT_THRESHOLD", 8388608);
+
+  if (ARMCII_GLOBAL_STATE.pack_nt_threshold < 0) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_PACK_NT_THRESHOLD (%d)\n", ARMCII_GLOBAL_STATE.pack_nt_threshold);
+    ARMCII_GLOBAL_STATE.pack_nt_threshold = 0;
+  }
+
+  ARMCII_GLOBAL_STATE.pack_threads=ARMCII_Getenv_int("ARMCI_PACK_THREADS", 1);
+
+  if (ARMCII_GLOBAL_STATE.pack_threads < 1) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_PACK_THREADS (%d)\n", ARMCII_GLOBAL_STATE.pack_threads);
+    ARMCII_GLOBAL_STATE.pack_threads = 1;
+  }
+#ifndef HAVE_PTHREADS
+  if (ARMCII_GLOBAL_STATE.pack_threads > 1) {
+    ARMCII_Warning("ARMCI_PACK_THREADS requires Pthreads support; using 1\n");
+    ARMCII_GLOBAL_STATE.pack_threads = 1;
+  }
+#endif
+
+  /* Split ARMCIX_*_large transfers into int-sized chunks; must be a multiple of
+   * every accumulate type size */
+
+  ARMCII_GLOBAL_STATE.large_chunk=ARMCII_Getenv_int("ARMCI_LARGE_CHUNK", 1073741824);
+
+  if (ARMCII_GLOBAL_STATE.large_chunk < 16 || ARMCII_GLOBAL_STATE.large_chunk % 16 != 0) {
+    ARMCII_Warning("Ignoring invalid value for ARMCI_LARGE_CHUNK (%d)\n", ARMCII_GLOBAL_STATE.large_chunk);
+    ARMCII_GLOBAL_STATE.large_chunk = 1073741824;
+  }
+
   /* Poke the MPI progress engine at the end of nonblocking (NB) calls */
 
   ARMCII_GLOBAL_STATE.explicit_nb_progress=ARMCII_Getenv_bool("ARMCI_EXPLICIT_NB_PROGRESS", 1);
@@ -231,9 +396,14 @@ int PARMCI_Init(void) {
 
   ARMCII_GLOBAL_STATE.use_alloc_shm=ARMCII_Getenv_bool("ARMCI_USE_ALLOC_SHM", 1);
 
-  /* Enable RMA element-wise atomicity */
+  /* Enable RMA element-wise atomicity (default policy of new allocations) */
 
-  ARMCII_GLOBAL_STATE.rma_atomicity=ARMCII_Getenv_bool("ARMCI_RMA_ATOMICITY", 1);
+  var = ARMCII_Getenv("ARMCI_RMA_ATOMICITY");
+  if (var != NULL && strcmp(var, "AUTO") == 0)
+    ARMCII_GLOBAL_STATE.rma_atomicity = ARMCIX_ATOMICITY_AUTO;
+  else
+    ARMCII_GLOBAL_STATE.rma_atomicity = ARMCII_Getenv_bool("ARMCI_RMA_ATOMICITY", 1) ?
+                                        ARMCIX_ATOMICITY_ON : ARMCIX_ATOMICITY_OFF;
 
   /* Flush_local becomes flush */
 
@@ -259,6 +429,19 @@ int PARMCI_Init(void) {
 
   ARMCII_GLOBAL_STATE.init_count++;
 
+  /* Time the IOV methods to set the AUTO thresholds */
+
+  if (   ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_AUTO
+      && ARMCII_Getenv_bool("ARMCI_IOV_AUTO_CALIBRATE", 0))
+    ARMCII_Iov_auto_calibrate();
+
+  /* Measure the cost model of the AUTO strided method */
+
+  if (   ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_AUTO
+      && ARMCII_GLOBAL_STATE.strided_auto_dtypes
+      && ARMCII_Getenv_bool("ARMCI_STRIDED_CALIBRATE", 0))
+    ARMCII_Strided_calibrate();
+
   if (ARMCII_GLOBAL_STATE.verbose) {
     if (ARMCI_GROUP_WORLD.rank == 0) {
       int major, minor;
@@ -278,8 +461,11 @@ int PARMCI_Init(void) {
 #endif
 
       printf("  ALLOC_SHM used         = %s\n", ARMCII_GLOBAL_STATE.use_alloc_shm ? "TRUE" : "FALSE");
-      printf("  WINDOW type used       = %s\n", ARMCII_GLOBAL_STATE.use_win_allocate ? "ALLOCATE" : "CREATE");
-      if (ARMCII_GLOBAL_STATE.use_win_allocate) {
+      printf("  WINDOW type used       = %s\n", ARMCII_GLOBAL_STATE.use_dynamic_window ? "DYNAMIC" :
+                                                  (ARMCII_GLOBAL_STATE.use_win_allocate_shared ? "ALLOCATE_SHARED" :
+                                                  (ARMCII_GLOBAL_STATE.use_win_allocate ? "ALLOCATE" : "CREATE")));
+      if (   ARMCII_GLOBAL_STATE.use_win_allocate && !ARMCII_GLOBAL_STATE.use_win_allocate_shared
+          && !ARMCII_GLOBAL_STATE.use_dynamic_window) {
           /* Jeff: Using win_allocate leads to correctness issues with some
            *       MPI implementations since 3c4ad2abc8c387fcdec3a7f3f44fa5fd75653ece. */
           /* This is required on Cray systems with CrayMPI 7.0.0 (at least) */
@@ -288,7 +474,32 @@ int PARMCI_Init(void) {
           ARMCII_Warning("MPI_Win_allocate can lead to correctness issues.\n");
       }
 
+      if (ARMCII_GLOBAL_STATE.use_dynamic_window) {
+          printf("  DYNAMIC_WINDOW_ATTACH_LIMIT = %d\n", ARMCII_GLOBAL_STATE.dynamic_window_attach_limit);
+      }
+
+      if (ARMCII_GLOBAL_STATE.slab_threshold > 0 && !ARMCII_GLOBAL_STATE.use_dynamic_window) {
+          printf("  SLAB_THRESHOLD         = %d\n", ARMCII_GLOBAL_STATE.slab_threshold);
+          printf("  SLAB_SIZE              = %d\n", ARMCII_GLOBAL_STATE.slab_size);
+      }
+
+      printf("  SCRATCH_POOL_LIMIT     = %d\n", ARMCII_GLOBAL_STATE.scratch_pool_limit);
+      printf("  PACK_NT_THRESHOLD      = %d\n", ARMCII_GLOBAL_STATE.pack_nt_threshold);
+      printf("  PACK_THREADS           = %d\n", ARMCII_GLOBAL_STATE.pack_threads);
+      printf("  LARGE_CHUNK            = %d\n", ARMCII_GLOBAL_STATE.large_chunk);
+      printf("  RMA_REQUESTS           = %s\n", ARMCII_GLOBAL_STATE.use_rma_requests ? "ENABLED" : "DISABLED");
+      printf("  RMA_ATOMICITY          = %s\n", (ARMCII_GLOBAL_STATE.rma_atomicity == ARMCIX_ATOMICITY_AUTO) ? "AUTO" :
+                                                  (ARMCII_GLOBAL_STATE.rma_atomicity == ARMCIX_ATOMICITY_ON) ? "TRUE" : "FALSE");
+      printf("  SCALE_ISA              = %s\n", ARMCII_Scale_isa_str[ARMCII_GLOBAL_STATE.scale_isa]);
       printf("  STRIDED_METHOD         = %s\n", ARMCII_Strided_methods_str[ARMCII_GLOBAL_STATE.strided_method]);
+      if (ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_AUTO) {
+        printf("  STRIDED_AUTO_DATATYPES = %s\n", ARMCII_GLOBAL_STATE.strided_auto_dtypes ? "TRUE" : "FALSE");
+        printf("  STRIDED_COST           = op %.3g, dtype_block %.3g, dtype_byte %.3g, pack_byte %.3g\n",
+               ARMCII_GLOBAL_STATE.strided_cost_op, ARMCII_GLOBAL_STATE.strided_cost_dt_block,
+               ARMCII_GLOBAL_STATE.strided_cost_dt_byte, ARMCII_GLOBAL_STATE.strided_cost_pack_byte);
+      }
+      if (ARMCII_GLOBAL_STATE.strided_method != ARMCII_STRIDED_IOV)
+        printf("  STRIDED_DTYPE_CACHE    = %d\n", ARMCII_GLOBAL_STATE.strided_dtype_cache);
       printf("  IOV_METHOD             = %s\n", ARMCII_Iov_methods_str[ARMCII_GLOBAL_STATE.iov_method]);
 
       if (   ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_BATCHED
@@ -300,6 +511,16 @@ int PARMCI_Init(void) {
           printf("  IOV_BATCHED_LIMIT      = UNLIMITED\n");
       }
 
+      if (ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_AUTO) {
+        printf("  IOV_AUTO_MIN_COUNT     = %d\n", ARMCII_GLOBAL_STATE.iov_auto_min_count);
+        printf("  IOV_AUTO_MAX_SIZE      = %d\n", ARMCII_GLOBAL_STATE.iov_auto_max_size);
+      }
+
+      if (   ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_IOV
+          || ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_AUTO)
+        printf("  IOV_CHUNK_LEN          = %d\n", ARMCII_GLOBAL_STATE.iov_chunk_len);
+
+      printf("  IOV_COALESCE           = %s\n", ARMCII_GLOBAL_STATE.iov_coalesce           ? "TRUE" : "FALSE");
       printf("  IOV_CHECKS             = %s\n", ARMCII_GLOBAL_STATE.iov_checks             ? "TRUE" : "FALSE");
       printf("  SHR_BUF_METHOD         = %s\n", ARMCII_Shr_buf_methods_str[ARMCII_GLOBAL_STATE.shr_buf_method]);
       printf("  NONCOLLECTIVE_GROUPS   = %s\n", ARMCII_GLOBAL_STATE.noncollective_groups   ? "TRUE" : "FALSE");
@@ -414,6 +635,10 @@ int PARMCI_Finalize(void) {
     }
 #endif
 
+  ARMCII_Hdl_free_all();
+  ARMCII_Scratch_free_all();
+  ARMCII_Strided_dtype_free_all();
+
   nfreed = gmr_destroy_all();
 
   if (nfreed > 0 && ARMCI_GROUP_WORLD.rank == 0)
@@ -16,7 +16,7 @@
 global_state_t ARMCII_GLOBAL_STATE = { 0 };
 
 /** Enum strings */
-char ARMCII_Strided_methods_str[][10] = { "IOV", "DIRECT" };
+char ARMCII_Strided_methods_str[][10] = { "IOV", "DIRECT", "PACK", "AUTO" };
 char ARMCII_Iov_methods_str[][10]     = { "AUTO", "CONSRV", "BATCHED", "DIRECT" };
 char ARMCII_Shr_buf_methods_str[][10] = { "COPY", "NOGUARD" };
 
@@ -156,3 +156,42 @@ int PARMCI_Free_local(void *buf) {
   MPI_Free_mem(buf);
   return 0;
 }
+
+
+/** Set the atomicity policy of put and get operations issued by the calling
+  * process on an allocation.  Operations issued under the previous policy
+  * are completed first.  Not collective.
+  *
+  * @param[in] ptr       Pointer to the local patch of the allocation
+  * @param[in] atomicity ARMCIX_ATOMICITY_OFF, _ON or _AUTO
+  * @return              0 on success, non-zero on failure
+  */
+int ARMCIX_Set_atomicity(void *ptr, int atomicity) {
+  gmr_t *mreg;
+
+  ARMCII_Assert_msg(atomicity == ARMCIX_ATOMICITY_OFF || atomicity == ARMCIX_ATOMICITY_ON ||
+                    atomicity == ARMCIX_ATOMICITY_AUTO, "Invalid atomicity policy");
+
+  mreg = gmr_lookup(ptr, ARMCI_GROUP_WORLD.rank);
+  ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
+
+  gmr_set_atomicity(mreg, atomicity);
+
+  return 0;
+}
+
+
+/** Get the atomicity policy of put and get operations issued by the calling
+  * process on an allocation.
+  *
+  * @param[in] ptr Pointer to the local patch of the allocation
+  * @return        ARMCIX_ATOMICITY_OFF, _ON or _AUTO
+  */
+int ARMCIX_Get_atomicity(void *ptr) {
+  gmr_t *mreg;
+
+  mreg = gmr_lookup(ptr, ARMCI_GROUP_WORLD.rank);
+  ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
+
+  return mreg->atomicity;
+}
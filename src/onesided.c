@@ -86,6 +86,7 @@ void PARMCI_Access_end(void *ptr) {
   */
 int PARMCI_Get(void *src, void *dst, int size, int target) {
   gmr_t *src_mreg, *dst_mreg;
+  void  *src_shm;
 
   src_mreg = gmr_lookup(src, target);
 
@@ -102,6 +103,13 @@ int PARMCI_Get(void *src, void *dst, int size, int target) {
     ARMCI_Copy(src, dst, size);
   }
 
+  /* Target is on this node: complete any RMA to it and load directly */
+  else if ((src_shm = gmr_shm_ptr(src_mreg, src, target)) != NULL) {
+    gmr_flush(src_mreg, target, 0);
+    gmr_sync(src_mreg);
+    ARMCI_Copy(src_shm, dst, size);
+  }
+
   /* Origin buffer is private */
   else if (dst_mreg == NULL) {
     gmr_get(src_mreg, src, dst, size, target);
@@ -114,7 +122,7 @@ int PARMCI_Get(void *src, void *dst, int size, int target) {
   else {
     void *dst_buf;
 
-    MPI_Alloc_mem(size, MPI_INFO_NULL, &dst_buf);
+    dst_buf = ARMCII_Scratch_get(size);
     ARMCII_Assert(dst_buf != NULL);
 
     gmr_get(src_mreg, src, dst_buf, size, target);
@@ -122,7 +130,7 @@ int PARMCI_Get(void *src, void *dst, int size, int target) {
 
     ARMCI_Copy(dst_buf, dst, size);
 
-    MPI_Free_mem(dst_buf);
+    ARMCII_Scratch_put(dst_buf);
   }
 
   return 0;
@@ -149,6 +157,7 @@ int PARMCI_Get(void *src, void *dst, int size, int target) {
   */
 int PARMCI_Put(void *src, void *dst, int size, int target) {
   gmr_t *src_mreg, *dst_mreg;
+  void  *dst_shm;
 
   dst_mreg = gmr_lookup(dst, target);
 
@@ -165,6 +174,13 @@ int PARMCI_Put(void *src, void *dst, int size, int target) {
     ARMCI_Copy(src, dst, size);
   }
 
+  /* Target is on this node: complete any RMA to it and store directly */
+  else if ((dst_shm = gmr_shm_ptr(dst_mreg, dst, target)) != NULL) {
+    gmr_flush(dst_mreg, target, 0);
+    ARMCI_Copy(src, dst_shm, size);
+    gmr_sync(dst_mreg);
+  }
+
   /* Origin buffer is private */
   else if (src_mreg == NULL) {
     gmr_put(dst_mreg, src, dst, size, target);
@@ -177,7 +193,7 @@ int PARMCI_Put(void *src, void *dst, int size, int target) {
   else {
     void *src_buf;
 
-    MPI_Alloc_mem(size, MPI_INFO_NULL, &src_buf);
+    src_buf = ARMCII_Scratch_get(size);
     ARMCII_Assert(src_buf != NULL);
 
     ARMCI_Copy(src, src_buf, size);
@@ -185,7 +201,7 @@ int PARMCI_Put(void *src, void *dst, int size, int target) {
     gmr_put(dst_mreg, src_buf, dst, size, target);
     gmr_flush(dst_mreg, target, 1); /* flush_local */
 
-    MPI_Free_mem(src_buf);
+    ARMCII_Scratch_put(src_buf);
   }
 
   return 0;
@@ -235,7 +251,7 @@ int PARMCI_Acc(int datatype, void *scale, void *src, void *dst, int bytes, int p
   scaled = ARMCII_Buf_acc_is_scaled(datatype, scale);
 
   if (scaled) {
-      MPI_Alloc_mem(bytes, MPI_INFO_NULL, &src_buf);
+      src_buf = ARMCII_Scratch_get(bytes);
       ARMCII_Assert(src_buf != NULL);
       ARMCII_Buf_acc_scale(src, src_buf, bytes, datatype, scale);
   } else {
@@ -246,7 +262,7 @@ int PARMCI_Acc(int datatype, void *scale, void *src, void *dst, int bytes, int p
   if (   (src_buf == src) /* buf_prepare didn't make a copy */
       && (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY || src_mreg == dst_mreg) )
   {
-    MPI_Alloc_mem(bytes, MPI_INFO_NULL, &src_buf);
+    src_buf = ARMCII_Scratch_get(bytes);
     ARMCII_Assert(src_buf != NULL);
     ARMCI_Copy(src, src_buf, bytes);
   }
@@ -263,7 +279,7 @@ int PARMCI_Acc(int datatype, void *scale, void *src, void *dst, int bytes, int p
   gmr_flush(dst_mreg, proc, 1); /* flush_local */
 
   if (src_buf != src)
-    MPI_Free_mem(src_buf);
+    ARMCII_Scratch_put(src_buf);
 
   return 0;
 }
@@ -0,0 +1,205 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <armci.h>
+#include <armcix.h>
+#include <armci_internals.h>
+#include <debug.h>
+#include <gmr.h>
+
+/** Contiguous transfers larger than 2 GiB.  The ARMCI interface counts bytes
+  * with an int, so these routines take an armci_size_t instead.  Transfers
+  * no larger than ARMCI_LARGE_CHUNK go through the regular routines.  Larger
+  * transfers between a private local buffer and a remote window are issued
+  * directly on the window: as a single operation when MPI provides
+  * large-count bindings, or as a pipeline of chunks that complete together
+  * otherwise.  Everything else (local, shared memory, shared local buffers and
+  * scaled accumulates) is split into int-sized calls to the regular routines.
+  */
+
+
+/** Issue a large transfer.
+  *
+  * @param[in] op       Operation
+  * @param[in] datatype ARMCI accumulate type (ARMCII_OP_ACC only)
+  * @param[in] scale    Accumulate scale factor (ARMCII_OP_ACC only)
+  * @param[in] src      Source address
+  * @param[in] dst      Destination address
+  * @param[in] bytes    Number of bytes to transfer
+  * @param[in] proc     Target process
+  * @param[in] blocking Wait for local completion before returning
+  * @param[in] handle   Nonblocking handle, or NULL for implicit handles
+  * @return             0 on success, non-zero on failure
+  */
+static int ARMCII_Large_op(enum ARMCII_Op_e op, int datatype, void *scale, void *src, void *dst,
+                           armci_size_t bytes, int proc, int blocking, armci_hdl_t *handle) {
+  void        *remote   = (op == ARMCII_OP_GET) ? src : dst;
+  void        *local    = (op == ARMCII_OP_GET) ? dst : src;
+  gmr_t       *mreg, *local_mreg = NULL;
+  armci_size_t off, chunk;
+  MPI_Datatype type = MPI_BYTE;
+  int          type_size = 1, direct;
+
+  ARMCII_Assert(bytes >= 0);
+
+  mreg = gmr_lookup(remote, proc);
+  ARMCII_Assert_msg(mreg != NULL, "Invalid remote pointer");
+
+  if (op == ARMCII_OP_ACC) {
+    ARMCII_Acc_type_translate(datatype, &type, &type_size);
+    ARMCII_Assert_msg(bytes % type_size == 0, "Transfer size is not a multiple of the datatype size");
+  }
+
+  /* If NOGUARD is set, assume the buffer is not shared */
+  if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_NOGUARD)
+    local_mreg = gmr_lookup(local, ARMCI_GROUP_WORLD.rank);
+
+  direct =    bytes > ARMCII_GLOBAL_STATE.large_chunk
+           && proc != ARMCI_GROUP_WORLD.rank
+           && local_mreg == NULL
+           && gmr_shm_ptr(mreg, remote, proc) == NULL
+           && !(op == ARMCII_OP_ACC && ARMCII_Buf_acc_is_scaled(datatype, scale));
+
+  if (!blocking)
+    ARMCII_Hdl_begin(handle);
+
+  if (!direct) {
+    /* The regular routines handle every buffer arrangement; each call
+     * completes before the next one is issued. */
+    for (off = 0; off < bytes; off += chunk) {
+      chunk = (bytes - off < ARMCII_GLOBAL_STATE.large_chunk) ? bytes - off : ARMCII_GLOBAL_STATE.large_chunk;
+
+      switch (op) {
+        case ARMCII_OP_PUT:
+          PARMCI_Put((uint8_t*)src + off, (uint8_t*)dst + off, (int) chunk, proc);
+          break;
+        case ARMCII_OP_GET:
+          PARMCI_Get((uint8_t*)src + off, (uint8_t*)dst + off, (int) chunk, proc);
+          break;
+        case ARMCII_OP_ACC:
+          PARMCI_Acc(datatype, scale, (uint8_t*)src + off, (uint8_t*)dst + off, (int) chunk, proc);
+          break;
+      }
+    }
+  } else {
+#ifdef GMR_LARGE_COUNT
+    const armci_size_t max_chunk = bytes;
+#else
+    const armci_size_t max_chunk = ARMCII_GLOBAL_STATE.large_chunk;
+#endif
+
+    /* Keep every chunk in flight and complete them together */
+    for (off = 0; off < bytes; off += chunk) {
+      chunk = (bytes - off < max_chunk) ? bytes - off : max_chunk;
+
+      switch (op) {
+        case ARMCII_OP_PUT:
+          gmr_put(mreg, (uint8_t*)src + off, (uint8_t*)dst + off, chunk, proc);
+          break;
+        case ARMCII_OP_GET:
+          gmr_get(mreg, (uint8_t*)src + off, (uint8_t*)dst + off, chunk, proc);
+          break;
+        case ARMCII_OP_ACC:
+          gmr_accumulate(mreg, (uint8_t*)src + off, (uint8_t*)dst + off, chunk/type_size, type, proc);
+          break;
+      }
+    }
+
+    /* A get is a round trip, so local completion requires a remote flush */
+    if (blocking)
+      gmr_flush(mreg, proc, op != ARMCII_OP_GET);
+  }
+
+  if (!blocking) {
+    ARMCII_Hdl_end(handle, proc);
+    gmr_progress();
+  }
+
+  return 0;
+}
+
+
+/** Blocking put of a contiguous buffer of any size.
+  *
+  * @param[in] src    Source address (local)
+  * @param[in] dst    Destination address (remote)
+  * @param[in] bytes  Number of bytes to transfer
+  * @param[in] proc   Process id to target
+  * @return           0 on success, non-zero on failure
+  */
+int ARMCIX_Put_large(void *src, void *dst, armci_size_t bytes, int proc) {
+  if (bytes <= ARMCII_GLOBAL_STATE.large_chunk)
+    return PARMCI_Put(src, dst, (int) bytes, proc);
+
+  return ARMCII_Large_op(ARMCII_OP_PUT, 0, NULL, src, dst, bytes, proc, 1, NULL);
+}
+
+
+/** Blocking get of a contiguous buffer of any size.
+  *
+  * @param[in] src    Source address (remote)
+  * @param[in] dst    Destination address (local)
+  * @param[in] bytes  Number of bytes to transfer
+  * @param[in] proc   Process id to target
+  * @return           0 on success, non-zero on failure
+  */
+int ARMCIX_Get_large(void *src, void *dst, armci_size_t bytes, int proc) {
+  if (bytes <= ARMCII_GLOBAL_STATE.large_chunk)
+    return PARMCI_Get(src, dst, (int) bytes, proc);
+
+  return ARMCII_Large_op(ARMCII_OP_GET, 0, NULL, src, dst, bytes, proc, 1, NULL);
+}
+
+
+/** Blocking accumulate of a contiguous buffer of any size.
+  *
+  * @param[in] datatype ARMCI data type for the accumulate operation (see armci.h)
+  * @param[in] scale    Pointer for a scalar of type datatype that will be used to
+  *                     scale values in the source buffer
+  * @param[in] src      Source address (local)
+  * @param[in] dst      Destination address (remote)
+  * @param[in] bytes    Number of bytes to transfer
+  * @param[in] proc     Process id to target
+  * @return             0 on success, non-zero on failure
+  */
+int ARMCIX_Acc_large(int datatype, void *scale, void *src, void *dst, armci_size_t bytes, int proc) {
+  if (bytes <= ARMCII_GLOBAL_STATE.large_chunk)
+    return PARMCI_Acc(datatype, scale, src, dst, (int) bytes, proc);
+
+  return ARMCII_Large_op(ARMCII_OP_ACC, datatype, scale, src, dst, bytes, proc, 1, NULL);
+}
+
+
+/** Nonblocking put of a contiguous buffer of any size.
+  */
+int ARMCIX_NbPut_large(void *src, void *dst, armci_size_t bytes, int proc, armci_hdl_t *handle) {
+  if (bytes <= ARMCII_GLOBAL_STATE.large_chunk)
+    return PARMCI_NbPut(src, dst, (int) bytes, proc, handle);
+
+  return ARMCII_Large_op(ARMCII_OP_PUT, 0, NULL, src, dst, bytes, proc, 0, handle);
+}
+
+
+/** Nonblocking get of a contiguous buffer of any size.
+  */
+int ARMCIX_NbGet_large(void *src, void *dst, armci_size_t bytes, int proc, armci_hdl_t *handle) {
+  if (bytes <= ARMCII_GLOBAL_STATE.large_chunk)
+    return PARMCI_NbGet(src, dst, (int) bytes, proc, handle);
+
+  return ARMCII_Large_op(ARMCII_OP_GET, 0, NULL, src, dst, bytes, proc, 0, handle);
+}
+
+
+/** Nonblocking accumulate of a contiguous buffer of any size.
+  */
+int ARMCIX_NbAcc_large(int datatype, void *scale, void *src, void *dst, armci_size_t bytes, int proc,
+                       armci_hdl_t *handle) {
+  if (bytes <= ARMCII_GLOBAL_STATE.large_chunk)
+    return PARMCI_NbAcc(datatype, scale, src, dst, (int) bytes, proc, handle);
+
+  return ARMCII_Large_op(ARMCII_OP_ACC, datatype, scale, src, dst, bytes, proc, 0, handle);
+}
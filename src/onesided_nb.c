@@ -4,17 +4,266 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include <armci.h>
+#include <armci_internals.h>
 #include <debug.h>
 #include <gmr.h>
 
+/** Work deferred until an operation completes: a temporary buffer to free
+  * and, for gets into shared buffers, a strided unpack of that buffer.
+  */
+typedef struct ARMCII_Deferred_s {
+  void                     *buf;           /* Temporary buffer from ARMCII_Scratch_get      */
+  int                       proc;          /* Target of the operation                       */
+  void                     *unpack_ptr;    /* Strided destination of buf, or NULL            */
+  int                       stride_levels;
+  int                      *stride_ar;     /* stride_levels strides followed by the counts  */
+  struct ARMCII_Deferred_s *next;
+} ARMCII_Deferred_t;
+
+/** Completion record of a nonblocking handle: the (window, target) pairs on
+  * which the handle's operations were issued, and work deferred until they
+  * complete.  Records live in a side table and a handle refers to its record
+  * by index.
+  */
+typedef struct {
+  armci_hdl_t       *handle;      /* Handle that owns this record, NULL if free */
+  gmr_target_set_t   targets;
+  ARMCII_Deferred_t *deferred;
+} ARMCII_Hdl_rec_t;
+
+static ARMCII_Hdl_rec_t  *ARMCII_Hdl_recs       = NULL;
+static int                ARMCII_Hdl_recs_count = 0;
+static ARMCII_Deferred_t *ARMCII_Hdl_implicit   = NULL; /* Deferred work of implicit handles */
+
+
+/** Find the completion record of a handle.  Handles that were not initialized
+  * or whose record was released do not match the record's owner.
+  */
+static ARMCII_Hdl_rec_t *ARMCII_Hdl_lookup(armci_hdl_t *handle) {
+  if (   handle->index >= 0 && handle->index < ARMCII_Hdl_recs_count
+      && ARMCII_Hdl_recs[handle->index].handle == handle)
+    return &ARMCII_Hdl_recs[handle->index];
+  else
+    return NULL;
+}
+
+
+/** Perform deferred work whose operations have completed and remove it from
+  * a list.
+  *
+  * @param[inout] list Deferred work list
+  * @param[in]    proc Retire only work for this target, or -1 for all
+  */
+static void ARMCII_Deferred_retire(ARMCII_Deferred_t **list, int proc) {
+  ARMCII_Deferred_t **prev = list;
+
+  while (*prev != NULL) {
+    ARMCII_Deferred_t *cur = *prev;
+
+    if (proc >= 0 && cur->proc != proc) {
+      prev = &cur->next;
+      continue;
+    }
+
+    if (cur->unpack_ptr != NULL)
+      armci_read_strided(cur->unpack_ptr, cur->stride_levels, cur->stride_ar,
+                         cur->stride_ar + cur->stride_levels, cur->buf);
+
+    ARMCII_Scratch_put(cur->buf);
+    free(cur->stride_ar);
+
+    *prev = cur->next;
+    free(cur);
+  }
+}
+
+
+/** Complete a record's operations and retire its deferred work.  Requests and
+  * targets are only completed when there is deferred work that needs them.
+  */
+static void ARMCII_Hdl_rec_retire(ARMCII_Hdl_rec_t *rec) {
+  if (rec->deferred == NULL)
+    return;
+
+  gmr_complete_set(&rec->targets, 1); /* local only */
+  ARMCII_Deferred_retire(&rec->deferred, -1);
+}
+
+
+/** Release the completion record of a handle, if it has one.
+  */
+static void ARMCII_Hdl_release(armci_hdl_t *handle) {
+  ARMCII_Hdl_rec_t *rec = ARMCII_Hdl_lookup(handle);
+
+  if (rec != NULL) {
+    ARMCII_Hdl_rec_retire(rec);
+    rec->handle = NULL;
+    gmr_clear_set(&rec->targets);
+  }
+
+  handle->index = -1;
+}
+
+
+/** Start recording the operations issued on behalf of a handle.  Aggregate
+  * handles accumulate operations until they are waited on; other handles only
+  * cover their most recent operation.
+  *
+  * @param[in] handle Nonblocking handle or NULL for implicit handles
+  */
+void ARMCII_Hdl_begin(armci_hdl_t *handle) {
+  ARMCII_Hdl_rec_t *rec;
+  int i;
+
+  if (handle == NULL)
+    return;
+
+  rec = ARMCII_Hdl_lookup(handle);
+
+  if (rec == NULL) {
+    for (i = 0; i < ARMCII_Hdl_recs_count; i++)
+      if (ARMCII_Hdl_recs[i].handle == NULL)
+        break;
+
+    if (i == ARMCII_Hdl_recs_count) {
+      int new_count = (ARMCII_Hdl_recs_count > 0) ? 2*ARMCII_Hdl_recs_count : 16;
+
+      ARMCII_Hdl_recs = realloc(ARMCII_Hdl_recs, sizeof(ARMCII_Hdl_rec_t)*new_count);
+      ARMCII_Assert(ARMCII_Hdl_recs != NULL);
+      memset(&ARMCII_Hdl_recs[ARMCII_Hdl_recs_count], 0,
+             sizeof(ARMCII_Hdl_rec_t)*(new_count - ARMCII_Hdl_recs_count));
+      ARMCII_Hdl_recs_count = new_count;
+    }
+
+    rec           = &ARMCII_Hdl_recs[i];
+    rec->handle   = handle;
+    handle->index = i;
+
+  } else if (!handle->aggregate) {
+    ARMCII_Hdl_rec_retire(rec);
+    gmr_clear_set(&rec->targets);
+  }
+
+  gmr_target_set = &rec->targets;
+}
+
+
+/** Stop recording operations for a handle.
+  *
+  * @param[in] handle Nonblocking handle or NULL for implicit handles
+  * @param[in] proc   Target of the operation
+  */
+void ARMCII_Hdl_end(armci_hdl_t *handle, int proc) {
+  gmr_target_set = NULL;
+
+  if (handle != NULL)
+    handle->target = proc;
+}
+
+
+/** Defer work until an operation issued on behalf of a handle completes.
+  * Work on an explicit handle is retired when the handle is waited on or
+  * tested complete; work on an implicit handle is retired by ARMCI_WaitAll,
+  * ARMCI_WaitProc or a fence on its target.
+  *
+  * @param[in] handle        Nonblocking handle or NULL for implicit handles
+  * @param[in] proc          Target of the operation
+  * @param[in] buf           Temporary buffer to return with ARMCII_Scratch_put
+  * @param[in] unpack_ptr    Strided destination to unpack buf into, or NULL
+  * @param[in] stride_ar     Strides of the destination
+  * @param[in] count         Block size in each dimension
+  * @param[in] stride_levels Number of stride levels
+  */
+void ARMCII_Hdl_defer(armci_hdl_t *handle, int proc, void *buf, void *unpack_ptr,
+                      int stride_ar[], int count[], int stride_levels) {
+  ARMCII_Deferred_t *def = malloc(sizeof(ARMCII_Deferred_t));
+  ARMCII_Assert(def != NULL);
+
+  def->buf           = buf;
+  def->proc          = proc;
+  def->unpack_ptr    = unpack_ptr;
+  def->stride_levels = stride_levels;
+  def->stride_ar     = NULL;
+
+  if (unpack_ptr != NULL) {
+    def->stride_ar = malloc(sizeof(int)*(2*stride_levels+1));
+    ARMCII_Assert(def->stride_ar != NULL);
+    memcpy(def->stride_ar, stride_ar, sizeof(int)*stride_levels);
+    memcpy(def->stride_ar + stride_levels, count, sizeof(int)*(stride_levels+1));
+  }
+
+  if (handle != NULL) {
+    ARMCII_Hdl_rec_t *rec = ARMCII_Hdl_lookup(handle);
+    ARMCII_Assert_msg(rec != NULL, "Deferred work on a handle without a record");
+
+    def->next     = rec->deferred;
+    rec->deferred = def;
+  } else {
+    def->next           = ARMCII_Hdl_implicit;
+    ARMCII_Hdl_implicit = def;
+  }
+}
+
+
+/** Retire the deferred work of implicit handles.  The caller must have
+  * completed the operations to the given target.
+  *
+  * @param[in] proc Target whose operations completed, or -1 for all targets
+  */
+void ARMCII_Hdl_retire_implicit(int proc) {
+  ARMCII_Deferred_retire(&ARMCII_Hdl_implicit, proc);
+}
+
+
+/** Remove a window from the completion records of all handles (called when the
+  * window is freed).
+  *
+  * @param[in] owner Region that owns the window
+  */
+void ARMCII_Hdl_purge(gmr_t *owner) {
+  int i;
+
+  for (i = 0; i < ARMCII_Hdl_recs_count; i++)
+    if (ARMCII_Hdl_recs[i].targets.count > 0)
+      gmr_purge_set(&ARMCII_Hdl_recs[i].targets, owner);
+}
+
+
+/** Free the handle completion records (called by finalize).
+  */
+void ARMCII_Hdl_free_all(void) {
+  int i;
+
+  if (ARMCII_Hdl_implicit != NULL)
+    PARMCI_WaitAll();
+
+  for (i = 0; i < ARMCII_Hdl_recs_count; i++) {
+    if (ARMCII_Hdl_recs[i].handle != NULL)
+      ARMCII_Hdl_rec_retire(&ARMCII_Hdl_recs[i]);
+
+    gmr_free_set(&ARMCII_Hdl_recs[i].targets);
+  }
+
+  free(ARMCII_Hdl_recs);
+  ARMCII_Hdl_recs       = NULL;
+  ARMCII_Hdl_recs_count = 0;
+}
+
+
 /** Initialize Non-blocking handle.
   */
 void ARMCI_INIT_HANDLE(armci_hdl_t *handle) {
   if (handle!=NULL) {
+    /* Forget a record left from a previous use of the handle */
+    if (ARMCII_Hdl_lookup(handle) != NULL)
+      ARMCII_Hdl_release(handle);
+
     handle->aggregate =  1;
     handle->target    = -1;
+    handle->index     = -1;
   } else {
     ARMCII_Warning("ARMCI_INIT_HANDLE given NULL handle");
   }
@@ -71,6 +320,8 @@ int PARMCI_NbPut(void *src, void *dst, int size, int target, armci_hdl_t *handle
 
   ARMCII_Assert_msg(dst_mreg != NULL, "Invalid remote pointer");
 
+  ARMCII_Hdl_begin(handle);
+
   /* Local operation */
   if (target == ARMCI_GROUP_WORLD.rank && src_mreg == NULL) {
       ARMCI_Copy(src, dst, size);
@@ -79,10 +330,7 @@ int PARMCI_NbPut(void *src, void *dst, int size, int target, armci_hdl_t *handle
       gmr_put(dst_mreg, src, dst, size, target);
   }
 
-  if (handle!=NULL) {
-      /* Regular (not aggregate) handles merely store the target for future flushing. */
-      handle->target = target;
-  }
+  ARMCII_Hdl_end(handle, target);
 
   gmr_progress();
 
@@ -115,6 +363,8 @@ int PARMCI_NbGet(void *src, void *dst, int size, int target, armci_hdl_t *handle
 
   ARMCII_Assert_msg(src_mreg != NULL, "Invalid remote pointer");
 
+  ARMCII_Hdl_begin(handle);
+
   /* Local operation */
   if (target == ARMCI_GROUP_WORLD.rank && dst_mreg == NULL) {
     ARMCI_Copy(src, dst, size);
@@ -123,10 +373,7 @@ int PARMCI_NbGet(void *src, void *dst, int size, int target, armci_hdl_t *handle
     gmr_get(src_mreg, src, dst, size, target);
   }
 
-  if (handle!=NULL) {
-      /* Regular (not aggregate) handles merely store the target for future flushing. */
-      handle->target = target;
-  }
+  ARMCII_Hdl_end(handle, target);
 
   gmr_progress();
 
@@ -144,7 +391,7 @@ int PARMCI_NbGet(void *src, void *dst, int size, int target, armci_hdl_t *handle
 #endif
 /* -- end weak symbols block -- */
 
-/** Non-blocking accumulate operation.  Note: the implementation is not non-blocking
+/** Non-blocking accumulate operation.
   */
 int PARMCI_NbAcc(int datatype, void *scale, void *src, void *dst, int bytes, int target, armci_hdl_t *handle) {
   void  *src_buf;
@@ -168,7 +415,7 @@ int PARMCI_NbAcc(int datatype, void *scale, void *src, void *dst, int bytes, int
   scaled = ARMCII_Buf_acc_is_scaled(datatype, scale);
 
   if (scaled) {
-      MPI_Alloc_mem(bytes, MPI_INFO_NULL, &src_buf);
+      src_buf = ARMCII_Scratch_get(bytes);
       ARMCII_Assert(src_buf != NULL);
       ARMCII_Buf_acc_scale(src, src_buf, bytes, datatype, scale);
   } else {
@@ -179,7 +426,7 @@ int PARMCI_NbAcc(int datatype, void *scale, void *src, void *dst, int bytes, int
   if (   (src_buf == src) /* buf_prepare didn't make a copy */
       && (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY || src_mreg == dst_mreg) )
   {
-    MPI_Alloc_mem(bytes, MPI_INFO_NULL, &src_buf);
+    src_buf = ARMCII_Scratch_get(bytes);
     ARMCII_Assert(src_buf != NULL);
     ARMCI_Copy(src, src_buf, bytes);
   }
@@ -192,18 +439,13 @@ int PARMCI_NbAcc(int datatype, void *scale, void *src, void *dst, int bytes, int
 
   /* TODO: Support a local accumulate operation more efficiently */
 
+  ARMCII_Hdl_begin(handle);
   gmr_accumulate(dst_mreg, src_buf, dst, count, type, target);
+  ARMCII_Hdl_end(handle, target);
 
-  if (src_buf != src) {
-    /* must wait for local completion to free source buffer */
-    gmr_flush(dst_mreg, target, 1); /* flush local only, unlike Fence */
-    MPI_Free_mem(src_buf);
-  }
-
-  if (handle!=NULL) {
-      /* Regular (not aggregate) handles merely store the target for future flushing. */
-      handle->target = target;
-  }
+  /* The source buffer can be freed once the handle completes */
+  if (src_buf != src)
+    ARMCII_Hdl_defer(handle, target, src_buf, NULL, NULL, NULL, 0);
 
   gmr_progress();
 
@@ -224,19 +466,33 @@ int PARMCI_NbAcc(int datatype, void *scale, void *src, void *dst, int bytes, int
 /** Wait for a non-blocking operation to finish.
   */
 int PARMCI_Wait(armci_hdl_t* handle) {
-  gmr_t *cur_mreg = gmr_list;
+  gmr_t *cur_mreg = gmr_dirty_list;
+  ARMCII_Hdl_rec_t *rec = ARMCII_Hdl_lookup(handle);
+
+  /* Complete only the (window, target) pairs covered by the handle */
+  if (rec != NULL) {
+    gmr_complete_set(&rec->targets, 1); /* local only */
+    ARMCII_Deferred_retire(&rec->deferred, -1);
+    ARMCII_Hdl_release(handle);
+    return 0;
+  }
 
+  /* Without a record, only windows with outstanding operations need to be
+   * flushed.  A flush can remove the window from the dirty list, so advance
+   * first. */
   if(handle->aggregate > 0) {
     while (cur_mreg) {
+      gmr_t *next = cur_mreg->dirty_next;
       gmr_flushall(cur_mreg, 1); /* local only */
-      cur_mreg = cur_mreg->next;
+      cur_mreg = next;
     }
   }
   else {
     int proc = handle->target;
     while (cur_mreg) {
+      gmr_t *next = cur_mreg->dirty_next;
       gmr_flush(cur_mreg, proc, 1); /* local only */
-      cur_mreg = cur_mreg->next;
+      cur_mreg = next;
     }
   }
   return 0;
@@ -253,9 +509,23 @@ int PARMCI_Wait(armci_hdl_t* handle) {
 #endif
 /* -- end weak symbols block -- */
 
-/** Check if a non-blocking operation has finished.
+/** Check if a non-blocking operation has finished.  Only handles whose
+  * operations were issued as MPI requests can be tested without blocking.
+  *
+  * @return 0 if the operation is complete, 1 otherwise.
   */
 int PARMCI_Test(armci_hdl_t* handle) {
+  ARMCII_Hdl_rec_t *rec = ARMCII_Hdl_lookup(handle);
+
+  if (rec != NULL && rec->targets.nrequests > 0) {
+    if (!gmr_test_set(&rec->targets))
+      return 1;
+
+    ARMCII_Deferred_retire(&rec->deferred, -1);
+    ARMCII_Hdl_release(handle);
+    return 0;
+  }
+
   return PARMCI_Wait(handle);
 }
 
@@ -273,12 +543,15 @@ int PARMCI_Test(armci_hdl_t* handle) {
 /** Wait for all outstanding non-blocking operations with implicit handles to a particular process to finish.
   */
 int PARMCI_WaitProc(int proc) {
-  gmr_t *cur_mreg = gmr_list;
+  gmr_t *cur_mreg = gmr_dirty_list;
 
   while (cur_mreg) {
+    gmr_t *next = cur_mreg->dirty_next;
     gmr_flush(cur_mreg, proc, 1); /* local only */
-    cur_mreg = cur_mreg->next;
+    cur_mreg = next;
   }
+
+  ARMCII_Hdl_retire_implicit(proc);
   return 0;
 }
 
@@ -296,12 +569,15 @@ int PARMCI_WaitProc(int proc) {
 /** Wait for all non-blocking operations with implicit (NULL) handles to finish.
   */
 int PARMCI_WaitAll(void) {
-  gmr_t *cur_mreg = gmr_list;
+  gmr_t *cur_mreg = gmr_dirty_list;
 
   while (cur_mreg) {
+    gmr_t *next = cur_mreg->dirty_next;
     gmr_flushall(cur_mreg, 1); /* local only */
-    cur_mreg = cur_mreg->next;
+    cur_mreg = next;
   }
+
+  ARMCII_Hdl_retire_implicit(-1);
   return 0;
 }
 
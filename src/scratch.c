@@ -0,0 +1,146 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <armci.h>
+#include <armci_internals.h>
+#include <debug.h>
+
+/** Scratch buffer pool.  Temporary buffers used for scaling, shared buffer
+  * copies and strided packing are allocated with MPI_Alloc_mem, which can
+  * register memory with the network and is expensive on many MPI stacks.
+  * Returned buffers are kept on per size class free lists and reused, up to a
+  * limit on the total number of bytes cached.
+  *
+  * Each buffer is preceded by a header that records its size class so that it
+  * can be returned without the caller passing its size.  Requests larger than
+  * the largest class bypass the pool.
+  */
+
+#define SCRATCH_MIN_CLASS_LOG2 6  /* Smallest class is 64 bytes */
+#define SCRATCH_NUM_CLASSES    17 /* Largest class is 4 MiB     */
+#define SCRATCH_UNPOOLED       -1
+
+typedef union scratch_hdr_u {
+  struct {
+    int                  size_class;  /* Size class or SCRATCH_UNPOOLED          */
+    union scratch_hdr_u *next;        /* Next free buffer of the same class      */
+  } info;
+  double                 align[8];    /* Keep the payload 64 byte aligned        */
+} scratch_hdr_t;
+
+static scratch_hdr_t *scratch_free_lists[SCRATCH_NUM_CLASSES];
+static size_t         scratch_cached_bytes = 0;
+
+#ifdef HAVE_PTHREADS
+static pthread_mutex_t scratch_lock = PTHREAD_MUTEX_INITIALIZER;
+#  define SCRATCH_LOCK()   pthread_mutex_lock(&scratch_lock)
+#  define SCRATCH_UNLOCK() pthread_mutex_unlock(&scratch_lock)
+#else
+#  define SCRATCH_LOCK()
+#  define SCRATCH_UNLOCK()
+#endif
+
+
+/** Size in bytes of the payload of a size class.
+  */
+static inline size_t scratch_class_size(int size_class) {
+  return ((size_t) 1) << (size_class + SCRATCH_MIN_CLASS_LOG2);
+}
+
+
+/** Smallest size class that holds size bytes, or SCRATCH_UNPOOLED.
+  */
+static inline int scratch_size_class(size_t size) {
+  int size_class = 0;
+
+  while (size_class < SCRATCH_NUM_CLASSES && scratch_class_size(size_class) < size)
+    size_class++;
+
+  return (size_class < SCRATCH_NUM_CLASSES) ? size_class : SCRATCH_UNPOOLED;
+}
+
+
+/** Check out a scratch buffer of at least size bytes.  The buffer is allocated
+  * with MPI_Alloc_mem and must be returned with ARMCII_Scratch_put.
+  *
+  * @param[in] size Number of bytes needed
+  * @return         Pointer to the buffer
+  */
+void *ARMCII_Scratch_get(size_t size) {
+  scratch_hdr_t *hdr = NULL;
+  int size_class = SCRATCH_UNPOOLED;
+
+  if (ARMCII_GLOBAL_STATE.scratch_pool_limit > 0)
+    size_class = scratch_size_class(size);
+
+  if (size_class != SCRATCH_UNPOOLED) {
+    SCRATCH_LOCK();
+    hdr = scratch_free_lists[size_class];
+
+    if (hdr != NULL) {
+      scratch_free_lists[size_class] = hdr->info.next;
+      scratch_cached_bytes -= scratch_class_size(size_class);
+    }
+    SCRATCH_UNLOCK();
+
+    size = scratch_class_size(size_class);
+  }
+
+  if (hdr == NULL) {
+    MPI_Alloc_mem(sizeof(scratch_hdr_t) + size, MPI_INFO_NULL, &hdr);
+    ARMCII_Assert(hdr != NULL);
+    hdr->info.size_class = size_class;
+  }
+
+  return hdr + 1;
+}
+
+
+/** Return a scratch buffer to the pool.  The buffer is freed if the pool
+  * already caches as many bytes as allowed by ARMCI_SCRATCH_POOL_LIMIT.
+  *
+  * @param[in] buf Buffer from ARMCII_Scratch_get
+  */
+void ARMCII_Scratch_put(void *buf) {
+  scratch_hdr_t *hdr = ((scratch_hdr_t *) buf) - 1;
+  int size_class     = hdr->info.size_class;
+
+  if (size_class != SCRATCH_UNPOOLED) {
+    size_t size = scratch_class_size(size_class);
+
+    SCRATCH_LOCK();
+    if (scratch_cached_bytes + size <= (size_t) ARMCII_GLOBAL_STATE.scratch_pool_limit) {
+      hdr->info.next = scratch_free_lists[size_class];
+      scratch_free_lists[size_class] = hdr;
+      scratch_cached_bytes += size;
+      hdr = NULL;
+    }
+    SCRATCH_UNLOCK();
+  }
+
+  if (hdr != NULL)
+    MPI_Free_mem(hdr);
+}
+
+
+/** Free all cached scratch buffers (called by finalize).
+  */
+void ARMCII_Scratch_free_all(void) {
+  int i;
+
+  SCRATCH_LOCK();
+  for (i = 0; i < SCRATCH_NUM_CLASSES; i++) {
+    while (scratch_free_lists[i] != NULL) {
+      scratch_hdr_t *hdr = scratch_free_lists[i];
+      scratch_free_lists[i] = hdr->info.next;
+      MPI_Free_mem(hdr);
+    }
+  }
+
+  scratch_cached_bytes = 0;
+  SCRATCH_UNLOCK();
+}
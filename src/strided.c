@@ -5,6 +5,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <limits.h>
 
 #include <armci.h>
 #include <armci_internals.h>
@@ -83,6 +84,56 @@ void ARMCII_Strided_to_dtype(int stride_array[/*stride_levels*/], int count[/*st
 }
 
 
+/** Normalize a strided descriptor.  Levels with a unit count are dropped and
+  * a level whose stride equals the extent of the levels below it on both the
+  * source and the destination is merged into them.  A patch that is
+  * contiguous on both sides normalizes to zero stride levels.
+  *
+  * The normalized descriptor may be written over the one it is computed from.
+  *
+  * @param[in]  src_stride_ar  Source array of stride distances in bytes.
+  * @param[in]  dst_stride_ar  Destination array of stride distances in bytes.
+  * @param[in]  count          Block size in each dimension; count[0] is in bytes.
+  * @param[in]  stride_levels  The level of strides.
+  * @param[out] new_src_stride Normalized source strides (stride_levels entries).
+  * @param[out] new_dst_stride Normalized destination strides (stride_levels entries).
+  * @param[out] new_count      Normalized counts (stride_levels+1 entries).
+  *
+  * @return                    Number of stride levels after normalization.
+  */
+int ARMCII_Strided_normalize(int src_stride_ar[/*stride_levels*/], int dst_stride_ar[/*stride_levels*/],
+                             int count[/*stride_levels+1*/], int stride_levels,
+                             int new_src_stride[], int new_dst_stride[], int new_count[]) {
+  int i, n = 0;
+
+  new_count[0] = count[0];
+
+  for (i = 1; i < stride_levels+1; i++) {
+    const int    cnt     = count[i];
+    const int    src_str = src_stride_ar[i-1];
+    const int    dst_str = dst_stride_ar[i-1];
+    armci_size_t src_ext, dst_ext;
+
+    if (cnt == 1) continue;
+
+    /* Extent of the levels below this one */
+    src_ext = (n == 0) ? (armci_size_t) new_count[0] : (armci_size_t) new_src_stride[n-1]*new_count[n];
+    dst_ext = (n == 0) ? (armci_size_t) new_count[0] : (armci_size_t) new_dst_stride[n-1]*new_count[n];
+
+    if (   src_ext == (armci_size_t) src_str && dst_ext == (armci_size_t) dst_str
+        && (armci_size_t) new_count[n]*cnt <= INT_MAX) {
+      new_count[n] *= cnt;
+    } else {
+      new_src_stride[n] = src_str;
+      new_dst_stride[n] = dst_str;
+      new_count[++n]    = cnt;
+    }
+  }
+
+  return n;
+}
+
+
 /* -- begin weak symbols block -- */
 #if defined(HAVE_PRAGMA_WEAK)
 #  pragma weak ARMCI_PutS = PARMCI_PutS
@@ -112,31 +163,62 @@ int PARMCI_PutS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
                int count[/*stride_levels+1*/], int stride_levels, int proc) {
 
   int err;
+  int n_src_stride[stride_levels+1], n_dst_stride[stride_levels+1], n_count[stride_levels+1];
+  enum ARMCII_Strided_methods_e method;
+
+  /* Drop degenerate levels and send contiguous patches down the contiguous path */
+  stride_levels = ARMCII_Strided_normalize(src_stride_ar, dst_stride_ar, count, stride_levels,
+                                           n_src_stride, n_dst_stride, n_count);
+  src_stride_ar = n_src_stride;
+  dst_stride_ar = n_dst_stride;
+  count         = n_count;
+
+  if (stride_levels == 0)
+    return PARMCI_Put(src_ptr, dst_ptr, count[0], proc);
+
+  /* Target is on this node: complete any RMA to it and store directly */
+  if (ARMCII_GLOBAL_STATE.use_win_allocate_shared) {
+    gmr_t *mreg = gmr_lookup(dst_ptr, proc);
+    void  *dst_shm;
+
+    ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
+    dst_shm = gmr_shm_ptr(mreg, dst_ptr, proc);
+
+    if (dst_shm != NULL) {
+      gmr_flush(mreg, proc, 0);
+      ARMCII_Strided_copy(src_ptr, src_stride_ar, dst_shm, dst_stride_ar, count, stride_levels);
+      gmr_sync(mreg);
+      return 0;
+    }
+  }
 
-  if (ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_DIRECT) {
+  method = ARMCII_Strided_method(count, stride_levels);
+
+  if (method != ARMCII_STRIDED_IOV) {
     void         *src_buf = NULL;
     gmr_t *mreg, *gmr_loc = NULL;
     MPI_Datatype src_type, dst_type;
 
     /* COPY: Guard shared buffers */
-    if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY) {
+    if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY)
       gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
 
-      if (gmr_loc != NULL) {
-        int i, size;
+    /* PACK or COPY: Send a packed copy of the source */
+    if (method == ARMCII_STRIDED_PACK || gmr_loc != NULL) {
+      armci_size_t size;
+      int          i;
 
-        for (i = 1, size = count[0]; i < stride_levels+1; i++)
-          size *= count[i];
+      for (i = 1, size = count[0]; i < stride_levels+1; i++)
+        size *= count[i];
 
-        MPI_Alloc_mem(size, MPI_INFO_NULL, &src_buf);
-        ARMCII_Assert(src_buf != NULL);
+      src_buf = ARMCII_Scratch_get(size);
+      ARMCII_Assert(src_buf != NULL);
 
-        armci_write_strided(src_ptr, stride_levels, src_stride_ar, count, src_buf);
+      armci_write_strided(src_ptr, stride_levels, src_stride_ar, count, src_buf);
 
-        MPI_Type_contiguous(size, MPI_BYTE, &src_type);
-      }
+      ARMCII_Dense_dtype(count, stride_levels, MPI_BYTE, &src_type);
     }
-    else {
+    else if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_COPY) {
       /* Jeff: WIN_UNIFIED should allow overlap to work but we
        *       do a memory barrier here to be safe. */
       gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
@@ -148,13 +230,10 @@ int PARMCI_PutS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
      * buffer is going to be used directly. */
     if (src_buf == NULL) { 
         src_buf = src_ptr;
-        ARMCII_Strided_to_dtype(src_stride_ar, count, stride_levels, MPI_BYTE, &src_type);
+        ARMCII_Strided_dtype(src_stride_ar, count, stride_levels, MPI_BYTE, &src_type);
     }
 
-    ARMCII_Strided_to_dtype(dst_stride_ar, count, stride_levels, MPI_BYTE, &dst_type);
-
-    MPI_Type_commit(&src_type);
-    MPI_Type_commit(&dst_type);
+    ARMCII_Strided_dtype(dst_stride_ar, count, stride_levels, MPI_BYTE, &dst_type);
 
     mreg = gmr_lookup(dst_ptr, proc);
     ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
@@ -162,24 +241,19 @@ int PARMCI_PutS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
     gmr_put_typed(mreg, src_buf, 1, src_type, dst_ptr, 1, dst_type, proc);
     gmr_flush(mreg, proc, 1); /* flush_local */
 
-    MPI_Type_free(&src_type);
-    MPI_Type_free(&dst_type);
+    ARMCII_Strided_dtype_done(&src_type);
+    ARMCII_Strided_dtype_done(&dst_type);
 
     /* COPY: Free temporary buffer */
     if (src_buf != src_ptr) {
-      MPI_Free_mem(src_buf);
+      ARMCII_Scratch_put(src_buf);
     }
 
     err = 0;
 
   } else {
-    armci_giov_t iov;
-
-    ARMCII_Strided_to_iov(&iov, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar, count, stride_levels);
-    err = PARMCI_PutV(&iov, 1, proc);
-
-    free(iov.src_ptr_array);
-    free(iov.dst_ptr_array);
+    err = ARMCII_Strided_iov_op(ARMCII_OP_PUT, 0, NULL, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar,
+                                count, stride_levels, proc, 1 /* blocking */, NULL);
   }
 
   return err;
@@ -215,29 +289,60 @@ int PARMCI_GetS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
                int count[/*stride_levels+1*/], int stride_levels, int proc) {
 
   int err;
+  int n_src_stride[stride_levels+1], n_dst_stride[stride_levels+1], n_count[stride_levels+1];
+  enum ARMCII_Strided_methods_e method;
+
+  /* Drop degenerate levels and send contiguous patches down the contiguous path */
+  stride_levels = ARMCII_Strided_normalize(src_stride_ar, dst_stride_ar, count, stride_levels,
+                                           n_src_stride, n_dst_stride, n_count);
+  src_stride_ar = n_src_stride;
+  dst_stride_ar = n_dst_stride;
+  count         = n_count;
+
+  if (stride_levels == 0)
+    return PARMCI_Get(src_ptr, dst_ptr, count[0], proc);
+
+  /* Target is on this node: complete any RMA to it and load directly */
+  if (ARMCII_GLOBAL_STATE.use_win_allocate_shared) {
+    gmr_t *mreg = gmr_lookup(src_ptr, proc);
+    void  *src_shm;
+
+    ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
+    src_shm = gmr_shm_ptr(mreg, src_ptr, proc);
+
+    if (src_shm != NULL) {
+      gmr_flush(mreg, proc, 0);
+      gmr_sync(mreg);
+      ARMCII_Strided_copy(src_shm, src_stride_ar, dst_ptr, dst_stride_ar, count, stride_levels);
+      return 0;
+    }
+  }
 
-  if (ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_DIRECT) {
+  method = ARMCII_Strided_method(count, stride_levels);
+
+  if (method != ARMCII_STRIDED_IOV) {
     void         *dst_buf = NULL;
     gmr_t *mreg, *gmr_loc = NULL;
     MPI_Datatype src_type, dst_type;
 
     /* COPY: Guard shared buffers */
-    if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY) {
+    if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY)
       gmr_loc = gmr_lookup(dst_ptr, ARMCI_GROUP_WORLD.rank);
 
-      if (gmr_loc != NULL) {
-        int i, size;
+    /* PACK or COPY: Receive into a packed buffer and unpack it */
+    if (method == ARMCII_STRIDED_PACK || gmr_loc != NULL) {
+      armci_size_t size;
+      int          i;
 
-        for (i = 1, size = count[0]; i < stride_levels+1; i++)
-          size *= count[i];
+      for (i = 1, size = count[0]; i < stride_levels+1; i++)
+        size *= count[i];
 
-        MPI_Alloc_mem(size, MPI_INFO_NULL, &dst_buf);
-        ARMCII_Assert(dst_buf != NULL);
+      dst_buf = ARMCII_Scratch_get(size);
+      ARMCII_Assert(dst_buf != NULL);
 
-        MPI_Type_contiguous(size, MPI_BYTE, &dst_type);
-      }
+      ARMCII_Dense_dtype(count, stride_levels, MPI_BYTE, &dst_type);
     }
-    else {
+    else if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_COPY) {
       /* Jeff: WIN_UNIFIED should allow overlap to work but we
        *       do a memory barrier here to be safe. */
       gmr_loc = gmr_lookup(dst_ptr, ARMCI_GROUP_WORLD.rank);
@@ -249,13 +354,10 @@ int PARMCI_GetS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
      * buffer is going to be used directly. */
     if (dst_buf == NULL) { 
         dst_buf = dst_ptr;
-        ARMCII_Strided_to_dtype(dst_stride_ar, count, stride_levels, MPI_BYTE, &dst_type);
+        ARMCII_Strided_dtype(dst_stride_ar, count, stride_levels, MPI_BYTE, &dst_type);
     }
 
-    ARMCII_Strided_to_dtype(src_stride_ar, count, stride_levels, MPI_BYTE, &src_type);
-
-    MPI_Type_commit(&src_type);
-    MPI_Type_commit(&dst_type);
+    ARMCII_Strided_dtype(src_stride_ar, count, stride_levels, MPI_BYTE, &src_type);
 
     mreg = gmr_lookup(src_ptr, proc);
     ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
@@ -266,22 +368,17 @@ int PARMCI_GetS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
     /* COPY: Finish the transfer */
     if (dst_buf != dst_ptr) {
       armci_read_strided(dst_ptr, stride_levels, dst_stride_ar, count, dst_buf);
-      MPI_Free_mem(dst_buf);
+      ARMCII_Scratch_put(dst_buf);
     }
 
-    MPI_Type_free(&src_type);
-    MPI_Type_free(&dst_type);
+    ARMCII_Strided_dtype_done(&src_type);
+    ARMCII_Strided_dtype_done(&dst_type);
 
     err = 0;
 
   } else {
-    armci_giov_t iov;
-
-    ARMCII_Strided_to_iov(&iov, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar, count, stride_levels);
-    err = PARMCI_GetV(&iov, 1, proc);
-
-    free(iov.src_ptr_array);
-    free(iov.dst_ptr_array);
+    err = ARMCII_Strided_iov_op(ARMCII_OP_GET, 0, NULL, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar,
+                                count, stride_levels, proc, 1 /* blocking */, NULL);
   }
 
   return err;
@@ -320,21 +417,39 @@ int PARMCI_AccS(int datatype, void *scale,
                int count[/*stride_levels+1*/], int stride_levels, int proc) {
 
   int err;
+  int n_src_stride[stride_levels+1], n_dst_stride[stride_levels+1], n_count[stride_levels+1];
+  enum ARMCII_Strided_methods_e method;
+
+  /* Drop degenerate levels and send contiguous patches down the contiguous path */
+  stride_levels = ARMCII_Strided_normalize(src_stride_ar, dst_stride_ar, count, stride_levels,
+                                           n_src_stride, n_dst_stride, n_count);
+  src_stride_ar = n_src_stride;
+  dst_stride_ar = n_dst_stride;
+  count         = n_count;
+
+  if (stride_levels == 0)
+    return PARMCI_Acc(datatype, scale, src_ptr, dst_ptr, count[0], proc);
+
+  method = ARMCII_Strided_method(count, stride_levels);
 
-  if (ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_DIRECT) {
+  if (method != ARMCII_STRIDED_IOV) {
     void         *src_buf = NULL;
     gmr_t *mreg, *gmr_loc = NULL;
     MPI_Datatype src_type, dst_type, mpi_datatype;
     int          scaled, mpi_datatype_size;
-    int          src_size, dst_size;
+    MPI_Count    src_size, dst_size;
 
     ARMCII_Acc_type_translate(datatype, &mpi_datatype, &mpi_datatype_size);
     scaled = ARMCII_Buf_acc_is_scaled(datatype, scale);
 
+    /* COPY: Guard shared buffers */
+    if (!scaled && ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY)
+      gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
+
     /* SCALE: copy and scale if requested */
     if (scaled) {
-      armci_giov_t iov;
-      int i, nelem;
+      armci_size_t nelem;
+      int          i;
 
       if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_NOGUARD)
         gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
@@ -342,40 +457,31 @@ int PARMCI_AccS(int datatype, void *scale,
       for (i = 1, nelem = count[0]/mpi_datatype_size; i < stride_levels+1; i++)
         nelem *= count[i];
 
-      MPI_Alloc_mem(nelem*mpi_datatype_size, MPI_INFO_NULL, &src_buf);
+      src_buf = ARMCII_Scratch_get(nelem*mpi_datatype_size);
       ARMCII_Assert(src_buf != NULL);
 
-      /* Shoehorn the strided information into an IOV */
-      ARMCII_Strided_to_iov(&iov, src_ptr, src_stride_ar, src_ptr, src_stride_ar, count, stride_levels);
-
-      for (i = 0; i < iov.ptr_array_len; i++)
-        ARMCII_Buf_acc_scale(iov.src_ptr_array[i], ((uint8_t*)src_buf) + i*iov.bytes, iov.bytes, datatype, scale);
+      /* Scale while packing into the contiguous buffer */
+      ARMCII_Buf_acc_scale_strided(src_ptr, src_stride_ar, count, stride_levels, src_buf, datatype, scale);
 
-      free(iov.src_ptr_array);
-      free(iov.dst_ptr_array);
-
-      MPI_Type_contiguous(nelem, mpi_datatype, &src_type);
+      ARMCII_Dense_dtype(count, stride_levels, mpi_datatype, &src_type);
     }
 
-    /* COPY: Guard shared buffers */
-    else if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY) {
-      gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
-
-      if (gmr_loc != NULL) {
-        int i, nelem;
+    /* PACK or COPY: Send a packed copy of the source */
+    else if (method == ARMCII_STRIDED_PACK || gmr_loc != NULL) {
+      armci_size_t nelem;
+      int          i;
 
-        for (i = 1, nelem = count[0]/mpi_datatype_size; i < stride_levels+1; i++)
-          nelem *= count[i];
+      for (i = 1, nelem = count[0]/mpi_datatype_size; i < stride_levels+1; i++)
+        nelem *= count[i];
 
-        MPI_Alloc_mem(nelem*mpi_datatype_size, MPI_INFO_NULL, &src_buf);
-        ARMCII_Assert(src_buf != NULL);
+      src_buf = ARMCII_Scratch_get(nelem*mpi_datatype_size);
+      ARMCII_Assert(src_buf != NULL);
 
-        armci_write_strided(src_ptr, stride_levels, src_stride_ar, count, src_buf);
+      armci_write_strided(src_ptr, stride_levels, src_stride_ar, count, src_buf);
 
-        MPI_Type_contiguous(nelem, mpi_datatype, &src_type);
-      }
+      ARMCII_Dense_dtype(count, stride_levels, mpi_datatype, &src_type);
     }
-    else {
+    else if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_COPY) {
       /* Jeff: WIN_UNIFIED should allow overlap to work but we
        *       do a memory barrier here to be safe. */
       gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
@@ -387,16 +493,13 @@ int PARMCI_AccS(int datatype, void *scale,
      * buffer is going to be used directly. */
     if (src_buf == NULL) { 
         src_buf = src_ptr;
-        ARMCII_Strided_to_dtype(src_stride_ar, count, stride_levels, mpi_datatype, &src_type);
+        ARMCII_Strided_dtype(src_stride_ar, count, stride_levels, mpi_datatype, &src_type);
     }
 
-    ARMCII_Strided_to_dtype(dst_stride_ar, count, stride_levels, mpi_datatype, &dst_type);
+    ARMCII_Strided_dtype(dst_stride_ar, count, stride_levels, mpi_datatype, &dst_type);
 
-    MPI_Type_commit(&src_type);
-    MPI_Type_commit(&dst_type);
-
-    MPI_Type_size(src_type, &src_size);
-    MPI_Type_size(dst_type, &dst_size);
+    MPI_Type_size_x(src_type, &src_size);
+    MPI_Type_size_x(dst_type, &dst_size);
 
     ARMCII_Assert(src_size == dst_size);
 
@@ -406,24 +509,19 @@ int PARMCI_AccS(int datatype, void *scale,
     gmr_accumulate_typed(mreg, src_buf, 1, src_type, dst_ptr, 1, dst_type, proc);
     gmr_flush(mreg, proc, 1); /* flush_local */
 
-    MPI_Type_free(&src_type);
-    MPI_Type_free(&dst_type);
+    ARMCII_Strided_dtype_done(&src_type);
+    ARMCII_Strided_dtype_done(&dst_type);
 
     /* COPY/SCALE: Free temp buffer */
     if (src_buf != src_ptr) {
-      MPI_Free_mem(src_buf);
+      ARMCII_Scratch_put(src_buf);
     }
 
     err = 0;
 
   } else {
-    armci_giov_t iov;
-
-    ARMCII_Strided_to_iov(&iov, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar, count, stride_levels);
-    err = PARMCI_AccV(datatype, scale, &iov, 1, proc);
-
-    free(iov.src_ptr_array);
-    free(iov.dst_ptr_array);
+    err = ARMCII_Strided_iov_op(ARMCII_OP_ACC, datatype, scale, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar,
+                                count, stride_levels, proc, 1 /* blocking */, NULL);
   }
 
   return err;
@@ -506,6 +604,56 @@ void ARMCII_Strided_to_iov(armci_giov_t *iov,
 }
 
 
+/** Copy between two strided buffers that are both directly accessible by the
+  * calling process.  This is a local operation.
+  *
+  * @param[in] src_ptr         Source starting address.
+  * @param[in] src_stride_arr  Source array of stride distances in bytes.
+  * @param[in] dst_ptr         Destination starting address.
+  * @param[in] dst_stride_ar   Destination array of stride distances in bytes.
+  * @param[in] count           Block size in each dimension. count[0] should be the
+  *                            number of bytes of contiguous data in leading dimension.
+  * @param[in] stride_levels   The level of strides.
+  */
+void ARMCII_Strided_copy(void *src_ptr, int src_stride_ar[/*stride_levels*/],
+               void *dst_ptr, int dst_stride_ar[/*stride_levels*/],
+               int count[/*stride_levels+1*/], int stride_levels) {
+
+  int idx[stride_levels+1];
+  int i;
+
+  if (stride_levels == 0) {
+    ARMCI_Copy(src_ptr, dst_ptr, count[0]);
+    return;
+  }
+
+  for (i = 0; i < stride_levels; i++)
+    idx[i] = 0;
+
+  while (idx[stride_levels-1] < count[stride_levels]) {
+    armci_size_t disp_src = 0;
+    armci_size_t disp_dst = 0;
+
+    for (i = 0; i < stride_levels; i++) {
+      disp_src += (armci_size_t) src_stride_ar[i]*idx[i];
+      disp_dst += (armci_size_t) dst_stride_ar[i]*idx[i];
+    }
+
+    ARMCI_Copy(((uint8_t*)src_ptr) + disp_src, ((uint8_t*)dst_ptr) + disp_dst, count[0]);
+
+    // Increment innermost index and propagate "carry" overflows outward
+    idx[0] += 1;
+
+    for (i = 0; i < stride_levels-1; i++) {
+      if (idx[i] >= count[i+1]) {
+        idx[i]    = 0;
+        idx[i+1] += 1;
+      }
+    }
+  }
+}
+
+
 /** Translate a strided operation into a more general IO Vector iterator.
   *
   * @param[in] src_ptr         Source starting address of the data block to put.
@@ -544,10 +692,12 @@ armcii_iov_iter_t *ARMCII_Strided_to_iov_iter(
   for (i = 0; i < stride_levels; i++) {
     it->src_stride_ar[i] = src_stride_ar[i];
     it->dst_stride_ar[i] = dst_stride_ar[i];
-    it->count[i]         = count[i];
     it->idx[i]           = 0;
   }
 
+  for (i = 0; i < stride_levels+1; i++)
+    it->count[i] = count[i];
+
   return it;
 }
 
@@ -569,7 +719,10 @@ void ARMCII_Iov_iter_free(armcii_iov_iter_t *it) {
   * @return             True if another iteration exists
   */
 int ARMCII_Iov_iter_has_next(armcii_iov_iter_t *it) {
-  return ((it->idx[it->stride_levels-1] < it->count[it->stride_levels]) && (!it->was_contiguous));
+  if (it->stride_levels == 0)
+    return !it->was_contiguous;
+
+  return it->idx[it->stride_levels-1] < it->count[it->stride_levels];
 }
 
 
@@ -591,18 +744,19 @@ int ARMCII_Iov_iter_next(armcii_iov_iter_t *it, void **src, void **dst) {
 
   // Case 1: Non-strided transfer
   if (it->stride_levels == 0) {
-    *src = src;
-    *dst = dst;
+    *src = it->src;
+    *dst = it->dst;
     it->was_contiguous = 1;
 
   // Case 2: Strided transfer
   } else {
-    int i, disp_src = 0, disp_dst = 0;
+    int i;
+    armci_size_t disp_src = 0, disp_dst = 0;
 
     // Calculate displacements from base pointers
     for (i = 0; i < it->stride_levels; i++) {
-      disp_src += it->src_stride_ar[i]*it->idx[i];
-      disp_dst += it->dst_stride_ar[i]*it->idx[i];
+      disp_src += (armci_size_t) it->src_stride_ar[i]*it->idx[i];
+      disp_dst += (armci_size_t) it->dst_stride_ar[i]*it->idx[i];
     }
 
     // Add to the IO Vector
@@ -625,6 +779,91 @@ int ARMCII_Iov_iter_next(armcii_iov_iter_t *it, void **src, void **dst) {
   return 1;
 }
 
+/** Perform a strided operation as a sequence of I/O vectors.  The blocks of
+  * the patch are generated ARMCI_IOV_CHUNK_LEN at a time by an IOV iterator,
+  * and each chunk is issued before the next one is generated, so memory use
+  * is bounded by the chunk length rather than by the size of the patch.
+  *
+  * @param[in] op              Operation to be performed (ARMCII_OP_PUT, ...)
+  * @param[in] datatype        Data type for accumulate op (ignored for all others)
+  * @param[in] scale           Scale for accumulate op (ignored for all others)
+  * @param[in] src_ptr         Source starting address.
+  * @param[in] src_stride_arr  Source array of stride distances in bytes.
+  * @param[in] dst_ptr         Destination starting address.
+  * @param[in] dst_stride_ar   Destination array of stride distances in bytes.
+  * @param[in] count           Block size in each dimension. count[0] should be the
+  *                            number of bytes of contiguous data in leading dimension.
+  * @param[in] stride_levels   The level of strides.
+  * @param[in] proc            Target process.
+  * @param[in] blocking        Complete the operation before returning.
+  * @param[in] handle          Handle of a nonblocking operation (may be NULL).
+  *
+  * @return                    Zero on success, error code otherwise.
+  */
+int ARMCII_Strided_iov_op(enum ARMCII_Op_e op, int datatype, void *scale,
+               void *src_ptr, int src_stride_ar[/*stride_levels*/],
+               void *dst_ptr, int dst_stride_ar[/*stride_levels*/],
+               int count[/*stride_levels+1*/], int stride_levels,
+               int proc, int blocking, armci_hdl_t *handle) {
+
+  armcii_iov_iter_t *it;
+  armci_hdl_t        blk_handle;
+  void             **src_ar, **dst_ar;
+  int                i, nblocks, chunk_len, tracked, err = 0;
+
+  for (i = 1, nblocks = 1; i < stride_levels+1; i++)
+    nblocks *= count[i];
+
+  if (nblocks == 0 || count[0] == 0) return 0; // NOP //
+
+  chunk_len = ARMCII_GLOBAL_STATE.iov_chunk_len;
+  if (chunk_len > nblocks)
+    chunk_len = nblocks;
+
+  /* A blocking operation split over several nonblocking chunks is completed
+   * through a handle that covers all of them.  Chunks that needed private
+   * copies of shared buffers are completed by ARMCII_Iov_op_vec itself. */
+  tracked = !blocking || chunk_len < nblocks;
+
+  if (!tracked) {
+    handle = NULL;
+  } else {
+    if (blocking) {
+      ARMCI_INIT_HANDLE(&blk_handle);
+      handle = &blk_handle;
+    }
+    ARMCII_Hdl_begin(handle);
+  }
+
+  src_ar = ARMCII_Scratch_get(2*chunk_len*sizeof(void*));
+  ARMCII_Assert(src_ar != NULL);
+  dst_ar = src_ar + chunk_len;
+
+  it = ARMCII_Strided_to_iov_iter(src_ptr, src_stride_ar, dst_ptr, dst_stride_ar, count, stride_levels);
+
+  while (ARMCII_Iov_iter_has_next(it) && err == 0) {
+    int n;
+
+    for (n = 0; n < chunk_len && ARMCII_Iov_iter_next(it, &src_ar[n], &dst_ar[n]); n++)
+      ;
+
+    err = ARMCII_Iov_op_vec(op, src_ar, dst_ar, n, count[0], datatype, scale, proc,
+                            !tracked, handle);
+  }
+
+  ARMCII_Iov_iter_free(it);
+  ARMCII_Scratch_put(src_ar);
+
+  if (tracked) {
+    ARMCII_Hdl_end(handle, proc);
+
+    if (blocking)
+      PARMCI_Wait(handle);
+  }
+
+  return err;
+}
+
 
 /* -- begin weak symbols block -- */
 #if defined(HAVE_PRAGMA_WEAK)
@@ -679,17 +918,7 @@ int PARMCI_PutS_flag(void *src_ptr, int src_stride_ar[/*stride_levels*/],
  */
 void armci_write_strided(void *src, int stride_levels, int src_stride_arr[],
                          int count[], char *dst) {
-  armci_giov_t iov;
-  int i;
-
-  // Shoehorn the strided information into an IOV
-  ARMCII_Strided_to_iov(&iov, src, src_stride_arr, src, src_stride_arr, count, stride_levels);
-
-  for (i = 0; i < iov.ptr_array_len; i++)
-    ARMCI_Copy(iov.src_ptr_array[i], dst + i*count[0], iov.bytes);
-
-  free(iov.src_ptr_array);
-  free(iov.dst_ptr_array);
+  ARMCII_Pack_strided(src, src_stride_arr, count, stride_levels, dst);
 }
 
 
@@ -704,15 +933,5 @@ void armci_write_strided(void *src, int stride_levels, int src_stride_arr[],
  */
 void armci_read_strided(void *dst, int stride_levels, int dst_stride_arr[],
                         int count[], char *src) {
-  armci_giov_t iov;
-  int i;
-
-  // Shoehorn the strided information into an IOV
-  ARMCII_Strided_to_iov(&iov, dst, dst_stride_arr, dst, dst_stride_arr, count, stride_levels);
-
-  for (i = 0; i < iov.ptr_array_len; i++)
-    ARMCI_Copy(src + i*count[0], iov.dst_ptr_array[i], iov.bytes);
-
-  free(iov.src_ptr_array);
-  free(iov.dst_ptr_array);
+  ARMCII_Unpack_strided(src, dst, dst_stride_arr, count, stride_levels);
 }
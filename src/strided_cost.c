@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <armci.h>
+#include <armci_internals.h>
+#include <debug.h>
+#include <gmr.h>
+
+/** Cost model for the AUTO strided method.  A strided patch of nblocks
+  * blocks holding bytes bytes in total is estimated to take
+  *
+  *   IOV:    nblocks * op
+  *   DIRECT: op + nblocks * dtype_block + bytes * dtype_byte
+  *   PACK:   op + nblocks * dtype_block/2 + bytes * (dtype_byte + pack_byte)
+  *
+  * where op is the cost of issuing one RMA operation, dtype_block and
+  * dtype_byte are the extra costs of a typed operation with both sides
+  * strided, and pack_byte is the cost of packing or unpacking one byte
+  * locally.  PACK describes only the remote side with a datatype, so it is
+  * charged half of the per-block datatype cost.  The time to move the bytes
+  * over the network is the same for every method and is left out.
+  *
+  * The parameters have built-in defaults, can be read from a file and can be
+  * measured by a short probe during initialization.
+  */
+
+#define COST_PROBE_REPS    5      /* Timed repetitions of each probe         */
+#define COST_PROBE_NSMALL  256    /* Blocks in the small block probes        */
+#define COST_PROBE_SMALL   8      /* Size of a small block                   */
+#define COST_PROBE_NLARGE  16     /* Blocks in the large block probes        */
+#define COST_PROBE_LARGE   65536  /* Size of a large block                   */
+#define COST_PROBE_BYTES   (2*COST_PROBE_NLARGE*COST_PROBE_LARGE)
+
+enum cost_probe_e { COST_PROBE_IOV, COST_PROBE_CONTIG, COST_PROBE_DTYPE_SMALL,
+                    COST_PROBE_DTYPE_LARGE, COST_PROBE_PACK };
+
+typedef struct {
+  uint8_t *loc;      /* Private source buffer                */
+  uint8_t *rem;      /* Target buffer on proc                */
+  char    *pack;     /* Packing buffer                       */
+  void   **src;      /* Block pointers for the IOV probe     */
+  void   **dst;
+  int     *len;
+  gmr_t   *mreg;
+  int      proc;
+} cost_probe_t;
+
+
+/** Select the strided method for one operation.  Returns the configured
+  * method unless it is AUTO, in which case the cheapest method according to
+  * the cost model is returned.  AUTO only chooses IOV when methods that use
+  * datatypes are disabled.
+  *
+  * @param[in] count         Normalized counts; count[0] is in bytes
+  * @param[in] stride_levels Number of levels of striding (at least one)
+  * @return                  ARMCII_STRIDED_IOV, _DIRECT or _PACK
+  */
+enum ARMCII_Strided_methods_e ARMCII_Strided_method(int count[], int stride_levels) {
+  double nblocks = 1.0, bytes, t_iov, t_direct, t_pack;
+  int    i;
+
+  if (ARMCII_GLOBAL_STATE.strided_method != ARMCII_STRIDED_AUTO)
+    return ARMCII_GLOBAL_STATE.strided_method;
+
+  if (!ARMCII_GLOBAL_STATE.strided_auto_dtypes)
+    return ARMCII_STRIDED_IOV;
+
+  for (i = 1; i < stride_levels+1; i++)
+    nblocks *= count[i];
+
+  bytes = nblocks*count[0];
+
+  t_iov    = nblocks*ARMCII_GLOBAL_STATE.strided_cost_op;
+  t_direct = ARMCII_GLOBAL_STATE.strided_cost_op + nblocks*ARMCII_GLOBAL_STATE.strided_cost_dt_block
+             + bytes*ARMCII_GLOBAL_STATE.strided_cost_dt_byte;
+  t_pack   = ARMCII_GLOBAL_STATE.strided_cost_op + nblocks*ARMCII_GLOBAL_STATE.strided_cost_dt_block/2
+             + bytes*(ARMCII_GLOBAL_STATE.strided_cost_dt_byte + ARMCII_GLOBAL_STATE.strided_cost_pack_byte);
+
+  if (t_iov < t_direct && t_iov < t_pack)
+    return ARMCII_STRIDED_IOV;
+  else if (t_pack < t_direct)
+    return ARMCII_STRIDED_PACK;
+  else
+    return ARMCII_STRIDED_DIRECT;
+}
+
+
+/** Set the cost model parameters to their defaults.
+  */
+void ARMCII_Strided_cost_defaults(void) {
+  ARMCII_GLOBAL_STATE.strided_cost_op        = 1.0e-6;
+  ARMCII_GLOBAL_STATE.strided_cost_dt_block  = 5.0e-8;
+  ARMCII_GLOBAL_STATE.strided_cost_dt_byte   = 0.0;
+  ARMCII_GLOBAL_STATE.strided_cost_pack_byte = 1.0e-10;
+}
+
+
+/** Read cost model parameters from a file.  Each line holds a parameter
+  * name (op, dtype_block, dtype_byte or pack_byte) and a value in seconds;
+  * lines starting with '#' are ignored.  Parameters that are not given keep
+  * their current value.
+  *
+  * @param[in] path Name of the file
+  * @return         Zero on success, non-zero if the file could not be read
+  */
+int ARMCII_Strided_cost_load(const char *path) {
+  FILE  *f;
+  char   line[256], name[64];
+  double value;
+
+  f = fopen(path, "r");
+  if (f == NULL)
+    return 1;
+
+  while (fgets(line, sizeof(line), f) != NULL) {
+    if (line[0] == '#' || sscanf(line, "%63s", name) != 1)
+      continue;
+
+    if (sscanf(line, "%63s %lf", name, &value) != 2 || value < 0) {
+      ARMCII_Warning("Ignoring invalid line in %s: %s", path, line);
+      continue;
+    }
+
+    if (strcmp(name, "op") == 0)
+      ARMCII_GLOBAL_STATE.strided_cost_op = value;
+    else if (strcmp(name, "dtype_block") == 0)
+      ARMCII_GLOBAL_STATE.strided_cost_dt_block = value;
+    else if (strcmp(name, "dtype_byte") == 0)
+      ARMCII_GLOBAL_STATE.strided_cost_dt_byte = value;
+    else if (strcmp(name, "pack_byte") == 0)
+      ARMCII_GLOBAL_STATE.strided_cost_pack_byte = value;
+    else
+      ARMCII_Warning("Ignoring unknown parameter in %s (%s)\n", path, name);
+  }
+
+  fclose(f);
+
+  return 0;
+}
+
+
+/** Run one calibration probe.
+  *
+  * @return Shortest time of COST_PROBE_REPS repetitions, after a warm-up
+  */
+static double cost_probe(enum cost_probe_e probe, cost_probe_t *p) {
+  int    small_count[2] = { COST_PROBE_SMALL, COST_PROBE_NSMALL };
+  int    large_count[2] = { COST_PROBE_LARGE, COST_PROBE_NLARGE };
+  int    small_stride   = 2*COST_PROBE_SMALL;
+  int    large_stride   = 2*COST_PROBE_LARGE;
+  double best = 0.0, t;
+  int    r;
+
+  for (r = 0; r <= COST_PROBE_REPS; r++) {
+    MPI_Datatype type;
+
+    t = MPI_Wtime();
+
+    switch (probe) {
+      case COST_PROBE_IOV:
+        ARMCII_Iov_op_batched(ARMCII_OP_PUT, p->src, p->dst, COST_PROBE_NSMALL, p->len, MPI_BYTE, p->proc, 0, 1);
+        break;
+      case COST_PROBE_CONTIG:
+        gmr_put(p->mreg, p->loc, p->rem, COST_PROBE_NLARGE*COST_PROBE_LARGE, p->proc);
+        gmr_flush(p->mreg, p->proc, 1);
+        break;
+      case COST_PROBE_DTYPE_SMALL:
+        ARMCII_Strided_dtype(&small_stride, small_count, 1, MPI_BYTE, &type);
+        gmr_put_typed(p->mreg, p->loc, 1, type, p->rem, 1, type, p->proc);
+        gmr_flush(p->mreg, p->proc, 1);
+        ARMCII_Strided_dtype_done(&type);
+        break;
+      case COST_PROBE_DTYPE_LARGE:
+        ARMCII_Strided_dtype(&large_stride, large_count, 1, MPI_BYTE, &type);
+        gmr_put_typed(p->mreg, p->loc, 1, type, p->rem, 1, type, p->proc);
+        gmr_flush(p->mreg, p->proc, 1);
+        ARMCII_Strided_dtype_done(&type);
+        break;
+      case COST_PROBE_PACK:
+        armci_write_strided(p->loc, 1, &large_stride, large_count, p->pack);
+        break;
+    }
+
+    t = MPI_Wtime() - t;
+
+    if (r == 1 || (r > 1 && t < best))
+      best = t;
+  }
+
+  return best;
+}
+
+
+/** Measure the cost model parameters with puts to the next process.  Times
+  * are reduced over all processes so that every process makes the same
+  * choices.  Collective on the world group.
+  */
+void ARMCII_Strided_calibrate(void) {
+  const int    rank  = ARMCI_GROUP_WORLD.rank;
+  const double large = (double) COST_PROBE_NLARGE*COST_PROBE_LARGE;
+  void       **base_ptrs;
+  cost_probe_t p;
+  double       t[5], op, dtype_block, dtype_byte;
+  int          i;
+
+  p.proc    = (rank+1) % ARMCI_GROUP_WORLD.size;
+  base_ptrs = malloc(sizeof(void*)*ARMCI_GROUP_WORLD.size);
+  p.src     = malloc(sizeof(void*)*COST_PROBE_NSMALL);
+  p.dst     = malloc(sizeof(void*)*COST_PROBE_NSMALL);
+  p.len     = malloc(sizeof(int)*COST_PROBE_NSMALL);
+  p.loc     = calloc(COST_PROBE_BYTES, 1);
+  p.pack    = malloc(COST_PROBE_NLARGE*COST_PROBE_LARGE);
+  ARMCII_Assert(base_ptrs != NULL && p.src != NULL && p.dst != NULL && p.len != NULL
+                && p.loc != NULL && p.pack != NULL);
+
+  ARMCI_Malloc_group(base_ptrs, COST_PROBE_BYTES, &ARMCI_GROUP_WORLD);
+
+  p.rem  = base_ptrs[p.proc];
+  p.mreg = gmr_lookup(p.rem, p.proc);
+  ARMCII_Assert(p.mreg != NULL);
+
+  for (i = 0; i < COST_PROBE_NSMALL; i++) {
+    p.src[i] = p.loc + 2*i*COST_PROBE_SMALL;
+    p.dst[i] = p.rem + 2*i*COST_PROBE_SMALL;
+    p.len[i] = COST_PROBE_SMALL;
+  }
+
+  t[COST_PROBE_IOV]         = cost_probe(COST_PROBE_IOV,         &p);
+  t[COST_PROBE_CONTIG]      = cost_probe(COST_PROBE_CONTIG,      &p);
+  t[COST_PROBE_DTYPE_SMALL] = cost_probe(COST_PROBE_DTYPE_SMALL, &p);
+  t[COST_PROBE_DTYPE_LARGE] = cost_probe(COST_PROBE_DTYPE_LARGE, &p);
+  t[COST_PROBE_PACK]        = cost_probe(COST_PROBE_PACK,        &p);
+
+  MPI_Allreduce(MPI_IN_PLACE, t, 5, MPI_DOUBLE, MPI_MAX, ARMCI_GROUP_WORLD.comm);
+
+  op          = t[COST_PROBE_IOV]/COST_PROBE_NSMALL;
+  dtype_block = (t[COST_PROBE_DTYPE_SMALL] - op)/COST_PROBE_NSMALL;
+  dtype_block = (dtype_block > 0) ? dtype_block : 0;
+  dtype_byte  = (t[COST_PROBE_DTYPE_LARGE] - op - COST_PROBE_NLARGE*dtype_block - t[COST_PROBE_CONTIG])/large;
+  dtype_byte  = (dtype_byte > 0) ? dtype_byte : 0;
+
+  ARMCII_GLOBAL_STATE.strided_cost_op        = op;
+  ARMCII_GLOBAL_STATE.strided_cost_dt_block  = dtype_block;
+  ARMCII_GLOBAL_STATE.strided_cost_dt_byte   = dtype_byte;
+  ARMCII_GLOBAL_STATE.strided_cost_pack_byte = t[COST_PROBE_PACK]/large;
+
+  ARMCI_Free_group(base_ptrs[rank], &ARMCI_GROUP_WORLD);
+
+  free(base_ptrs);
+  free(p.src);
+  free(p.dst);
+  free(p.len);
+  free(p.loc);
+  free(p.pack);
+}
@@ -41,31 +41,46 @@ int PARMCI_NbPutS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
                int count[/*stride_levels+1*/], int stride_levels, int proc, armci_hdl_t *handle) {
 
   int err;
+  int n_src_stride[stride_levels+1], n_dst_stride[stride_levels+1], n_count[stride_levels+1];
+  enum ARMCII_Strided_methods_e method;
 
-  if (ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_DIRECT) {
+  /* Drop degenerate levels and send contiguous patches down the contiguous path */
+  stride_levels = ARMCII_Strided_normalize(src_stride_ar, dst_stride_ar, count, stride_levels,
+                                           n_src_stride, n_dst_stride, n_count);
+  src_stride_ar = n_src_stride;
+  dst_stride_ar = n_dst_stride;
+  count         = n_count;
+
+  if (stride_levels == 0)
+    return PARMCI_NbPut(src_ptr, dst_ptr, count[0], proc, handle);
+
+  method = ARMCII_Strided_method(count, stride_levels);
+
+  if (method != ARMCII_STRIDED_IOV) {
     void         *src_buf = NULL;
     gmr_t *mreg, *gmr_loc = NULL;
     MPI_Datatype src_type, dst_type;
 
     /* COPY: Guard shared buffers */
-    if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY) {
+    if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY)
       gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
 
-      if (gmr_loc != NULL) {
-        int i, size;
+    /* PACK or COPY: Send a packed copy of the source */
+    if (method == ARMCII_STRIDED_PACK || gmr_loc != NULL) {
+      armci_size_t size;
+      int          i;
 
-        for (i = 1, size = count[0]; i < stride_levels+1; i++)
-          size *= count[i];
+      for (i = 1, size = count[0]; i < stride_levels+1; i++)
+        size *= count[i];
 
-        MPI_Alloc_mem(size, MPI_INFO_NULL, &src_buf);
-        ARMCII_Assert(src_buf != NULL);
+      src_buf = ARMCII_Scratch_get(size);
+      ARMCII_Assert(src_buf != NULL);
 
-        armci_write_strided(src_ptr, stride_levels, src_stride_ar, count, src_buf);
+      armci_write_strided(src_ptr, stride_levels, src_stride_ar, count, src_buf);
 
-        MPI_Type_contiguous(size, MPI_BYTE, &src_type);
-      }
+      ARMCII_Dense_dtype(count, stride_levels, MPI_BYTE, &src_type);
     }
-    else {
+    else if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_COPY) {
       /* Jeff: WIN_UNIFIED should allow overlap to work but we
        *       do a memory barrier here to be safe. */
       gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
@@ -77,43 +92,30 @@ int PARMCI_NbPutS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
      * buffer is going to be used directly. */
     if (src_buf == NULL) { 
         src_buf = src_ptr;
-        ARMCII_Strided_to_dtype(src_stride_ar, count, stride_levels, MPI_BYTE, &src_type);
+        ARMCII_Strided_dtype(src_stride_ar, count, stride_levels, MPI_BYTE, &src_type);
     }
 
-    ARMCII_Strided_to_dtype(dst_stride_ar, count, stride_levels, MPI_BYTE, &dst_type);
-
-    MPI_Type_commit(&src_type);
-    MPI_Type_commit(&dst_type);
+    ARMCII_Strided_dtype(dst_stride_ar, count, stride_levels, MPI_BYTE, &dst_type);
 
     mreg = gmr_lookup(dst_ptr, proc);
     ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
 
+    ARMCII_Hdl_begin(handle);
     gmr_put_typed(mreg, src_buf, 1, src_type, dst_ptr, 1, dst_type, proc);
+    ARMCII_Hdl_end(handle, proc);
 
-    MPI_Type_free(&src_type);
-    MPI_Type_free(&dst_type);
+    ARMCII_Strided_dtype_done(&src_type);
+    ARMCII_Strided_dtype_done(&dst_type);
 
-    /* COPY: Free temporary buffer */
-    if (src_buf != src_ptr) {
-      gmr_flush(mreg, proc, 1); /* flush_local */
-      MPI_Free_mem(src_buf);
-    }
-
-    if (handle!=NULL) {
-        /* Regular (not aggregate) handles merely store the target for future flushing. */
-        handle->target = proc;
-    }
+    /* COPY: Free temporary buffer once the handle completes */
+    if (src_buf != src_ptr)
+      ARMCII_Hdl_defer(handle, proc, src_buf, NULL, NULL, NULL, 0);
 
     err = 0;
 
   } else {
-    armci_giov_t iov;
-
-    ARMCII_Strided_to_iov(&iov, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar, count, stride_levels);
-    err = PARMCI_NbPutV(&iov, 1, proc, handle);
-
-    free(iov.src_ptr_array);
-    free(iov.dst_ptr_array);
+    err = ARMCII_Strided_iov_op(ARMCII_OP_PUT, 0, NULL, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar,
+                                count, stride_levels, proc, 0 /* nonblocking */, handle);
   }
 
   gmr_progress();
@@ -151,29 +153,44 @@ int PARMCI_NbGetS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
                int count[/*stride_levels+1*/], int stride_levels, int proc, armci_hdl_t *handle) {
 
   int err;
+  int n_src_stride[stride_levels+1], n_dst_stride[stride_levels+1], n_count[stride_levels+1];
+  enum ARMCII_Strided_methods_e method;
 
-  if (ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_DIRECT) {
+  /* Drop degenerate levels and send contiguous patches down the contiguous path */
+  stride_levels = ARMCII_Strided_normalize(src_stride_ar, dst_stride_ar, count, stride_levels,
+                                           n_src_stride, n_dst_stride, n_count);
+  src_stride_ar = n_src_stride;
+  dst_stride_ar = n_dst_stride;
+  count         = n_count;
+
+  if (stride_levels == 0)
+    return PARMCI_NbGet(src_ptr, dst_ptr, count[0], proc, handle);
+
+  method = ARMCII_Strided_method(count, stride_levels);
+
+  if (method != ARMCII_STRIDED_IOV) {
     void         *dst_buf = NULL;
     gmr_t *mreg, *gmr_loc = NULL;
     MPI_Datatype src_type, dst_type;
 
     /* COPY: Guard shared buffers */
-    if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY) {
+    if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY)
       gmr_loc = gmr_lookup(dst_ptr, ARMCI_GROUP_WORLD.rank);
 
-      if (gmr_loc != NULL) {
-        int i, size;
+    /* PACK or COPY: Receive into a packed buffer and unpack it */
+    if (method == ARMCII_STRIDED_PACK || gmr_loc != NULL) {
+      armci_size_t size;
+      int          i;
 
-        for (i = 1, size = count[0]; i < stride_levels+1; i++)
-          size *= count[i];
+      for (i = 1, size = count[0]; i < stride_levels+1; i++)
+        size *= count[i];
 
-        MPI_Alloc_mem(size, MPI_INFO_NULL, &dst_buf);
-        ARMCII_Assert(dst_buf != NULL);
+      dst_buf = ARMCII_Scratch_get(size);
+      ARMCII_Assert(dst_buf != NULL);
 
-        MPI_Type_contiguous(size, MPI_BYTE, &dst_type);
-      }
+      ARMCII_Dense_dtype(count, stride_levels, MPI_BYTE, &dst_type);
     }
-    else {
+    else if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_COPY) {
       /* Jeff: WIN_UNIFIED should allow overlap to work but we
        *       do a memory barrier here to be safe. */
       gmr_loc = gmr_lookup(dst_ptr, ARMCI_GROUP_WORLD.rank);
@@ -185,44 +202,30 @@ int PARMCI_NbGetS(void *src_ptr, int src_stride_ar[/*stride_levels*/],
      * buffer is going to be used directly. */
     if (dst_buf == NULL) { 
         dst_buf = dst_ptr;
-        ARMCII_Strided_to_dtype(dst_stride_ar, count, stride_levels, MPI_BYTE, &dst_type);
+        ARMCII_Strided_dtype(dst_stride_ar, count, stride_levels, MPI_BYTE, &dst_type);
     }
 
-    ARMCII_Strided_to_dtype(src_stride_ar, count, stride_levels, MPI_BYTE, &src_type);
-
-    MPI_Type_commit(&src_type);
-    MPI_Type_commit(&dst_type);
+    ARMCII_Strided_dtype(src_stride_ar, count, stride_levels, MPI_BYTE, &src_type);
 
     mreg = gmr_lookup(src_ptr, proc);
     ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
 
+    ARMCII_Hdl_begin(handle);
     gmr_get_typed(mreg, src_ptr, 1, src_type, dst_buf, 1, dst_type, proc);
+    ARMCII_Hdl_end(handle, proc);
 
-    /* COPY: Finish the transfer */
-    if (dst_buf != dst_ptr) {
-      gmr_flush(mreg, proc, 1);
-      armci_read_strided(dst_ptr, stride_levels, dst_stride_ar, count, dst_buf);
-      MPI_Free_mem(dst_buf);
-    }
-
-    MPI_Type_free(&src_type);
-    MPI_Type_free(&dst_type);
+    /* COPY: Finish the transfer once the handle completes */
+    if (dst_buf != dst_ptr)
+      ARMCII_Hdl_defer(handle, proc, dst_buf, dst_ptr, dst_stride_ar, count, stride_levels);
 
-    if (handle!=NULL) {
-        /* Regular (not aggregate) handles merely store the target for future flushing. */
-        handle->target = proc;
-    }
+    ARMCII_Strided_dtype_done(&src_type);
+    ARMCII_Strided_dtype_done(&dst_type);
 
     err = 0;
 
   } else {
-    armci_giov_t iov;
-
-    ARMCII_Strided_to_iov(&iov, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar, count, stride_levels);
-    err = PARMCI_NbGetV(&iov, 1, proc, handle);
-
-    free(iov.src_ptr_array);
-    free(iov.dst_ptr_array);
+    err = ARMCII_Strided_iov_op(ARMCII_OP_GET, 0, NULL, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar,
+                                count, stride_levels, proc, 0 /* nonblocking */, handle);
   }
 
   gmr_progress();
@@ -263,8 +266,22 @@ int PARMCI_NbAccS(int datatype, void *scale,
                int count[/*stride_levels+1*/], int stride_levels, int proc, armci_hdl_t *handle) {
 
   int err;
+  int n_src_stride[stride_levels+1], n_dst_stride[stride_levels+1], n_count[stride_levels+1];
+  enum ARMCII_Strided_methods_e method;
+
+  /* Drop degenerate levels and send contiguous patches down the contiguous path */
+  stride_levels = ARMCII_Strided_normalize(src_stride_ar, dst_stride_ar, count, stride_levels,
+                                           n_src_stride, n_dst_stride, n_count);
+  src_stride_ar = n_src_stride;
+  dst_stride_ar = n_dst_stride;
+  count         = n_count;
 
-  if (ARMCII_GLOBAL_STATE.strided_method == ARMCII_STRIDED_DIRECT) {
+  if (stride_levels == 0)
+    return PARMCI_NbAcc(datatype, scale, src_ptr, dst_ptr, count[0], proc, handle);
+
+  method = ARMCII_Strided_method(count, stride_levels);
+
+  if (method != ARMCII_STRIDED_IOV) {
     void         *src_buf = NULL;
     gmr_t *mreg, *gmr_loc = NULL;
     MPI_Datatype src_type, dst_type, mpi_datatype;
@@ -273,10 +290,14 @@ int PARMCI_NbAccS(int datatype, void *scale,
     ARMCII_Acc_type_translate(datatype, &mpi_datatype, &mpi_datatype_size);
     scaled = ARMCII_Buf_acc_is_scaled(datatype, scale);
 
+    /* COPY: Guard shared buffers */
+    if (!scaled && ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY)
+      gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
+
     /* SCALE: copy and scale if requested */
     if (scaled) {
-      armci_giov_t iov;
-      int i, nelem;
+      armci_size_t nelem;
+      int          i;
 
       if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_NOGUARD)
         gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
@@ -284,40 +305,31 @@ int PARMCI_NbAccS(int datatype, void *scale,
       for (i = 1, nelem = count[0]/mpi_datatype_size; i < stride_levels+1; i++)
         nelem *= count[i];
 
-      MPI_Alloc_mem(nelem*mpi_datatype_size, MPI_INFO_NULL, &src_buf);
+      src_buf = ARMCII_Scratch_get(nelem*mpi_datatype_size);
       ARMCII_Assert(src_buf != NULL);
 
-      /* Shoehorn the strided information into an IOV */
-      ARMCII_Strided_to_iov(&iov, src_ptr, src_stride_ar, src_ptr, src_stride_ar, count, stride_levels);
+      /* Scale while packing into the contiguous buffer */
+      ARMCII_Buf_acc_scale_strided(src_ptr, src_stride_ar, count, stride_levels, src_buf, datatype, scale);
 
-      for (i = 0; i < iov.ptr_array_len; i++)
-        ARMCII_Buf_acc_scale(iov.src_ptr_array[i], ((uint8_t*)src_buf) + i*iov.bytes, iov.bytes, datatype, scale);
-
-      free(iov.src_ptr_array);
-      free(iov.dst_ptr_array);
-
-      MPI_Type_contiguous(nelem, mpi_datatype, &src_type);
+      ARMCII_Dense_dtype(count, stride_levels, mpi_datatype, &src_type);
     }
 
-    /* COPY: Guard shared buffers */
-    else if (ARMCII_GLOBAL_STATE.shr_buf_method == ARMCII_SHR_BUF_COPY) {
-      gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
-
-      if (gmr_loc != NULL) {
-        int i, nelem;
+    /* PACK or COPY: Send a packed copy of the source */
+    else if (method == ARMCII_STRIDED_PACK || gmr_loc != NULL) {
+      armci_size_t nelem;
+      int          i;
 
-        for (i = 1, nelem = count[0]/mpi_datatype_size; i < stride_levels+1; i++)
-          nelem *= count[i];
+      for (i = 1, nelem = count[0]/mpi_datatype_size; i < stride_levels+1; i++)
+        nelem *= count[i];
 
-        MPI_Alloc_mem(nelem*mpi_datatype_size, MPI_INFO_NULL, &src_buf);
-        ARMCII_Assert(src_buf != NULL);
+      src_buf = ARMCII_Scratch_get(nelem*mpi_datatype_size);
+      ARMCII_Assert(src_buf != NULL);
 
-        armci_write_strided(src_ptr, stride_levels, src_stride_ar, count, src_buf);
+      armci_write_strided(src_ptr, stride_levels, src_stride_ar, count, src_buf);
 
-        MPI_Type_contiguous(nelem, mpi_datatype, &src_type);
-      }
+      ARMCII_Dense_dtype(count, stride_levels, mpi_datatype, &src_type);
     }
-    else {
+    else if (ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_COPY) {
       /* Jeff: WIN_UNIFIED should allow overlap to work but we
        *       do a memory barrier here to be safe. */
       gmr_loc = gmr_lookup(src_ptr, ARMCI_GROUP_WORLD.rank);
@@ -329,50 +341,37 @@ int PARMCI_NbAccS(int datatype, void *scale,
      * buffer is going to be used directly. */
     if (src_buf == NULL) { 
         src_buf = src_ptr;
-        ARMCII_Strided_to_dtype(src_stride_ar, count, stride_levels, mpi_datatype, &src_type);
+        ARMCII_Strided_dtype(src_stride_ar, count, stride_levels, mpi_datatype, &src_type);
     }
 
-    ARMCII_Strided_to_dtype(dst_stride_ar, count, stride_levels, mpi_datatype, &dst_type);
+    ARMCII_Strided_dtype(dst_stride_ar, count, stride_levels, mpi_datatype, &dst_type);
 
-    MPI_Type_commit(&src_type);
-    MPI_Type_commit(&dst_type);
+    MPI_Count src_size, dst_size;
 
-    int src_size, dst_size;
-
-    MPI_Type_size(src_type, &src_size);
-    MPI_Type_size(dst_type, &dst_size);
+    MPI_Type_size_x(src_type, &src_size);
+    MPI_Type_size_x(dst_type, &dst_size);
 
     ARMCII_Assert(src_size == dst_size);
 
     mreg = gmr_lookup(dst_ptr, proc);
     ARMCII_Assert_msg(mreg != NULL, "Invalid shared pointer");
 
+    ARMCII_Hdl_begin(handle);
     gmr_accumulate_typed(mreg, src_buf, 1, src_type, dst_ptr, 1, dst_type, proc);
+    ARMCII_Hdl_end(handle, proc);
 
-    MPI_Type_free(&src_type);
-    MPI_Type_free(&dst_type);
+    ARMCII_Strided_dtype_done(&src_type);
+    ARMCII_Strided_dtype_done(&dst_type);
 
-    /* COPY/SCALE: Free temp buffer */
-    if (src_buf != src_ptr) {
-      gmr_flush(mreg, proc, 1); /* flush_local */
-      MPI_Free_mem(src_buf);
-    }
-
-    if (handle!=NULL) {
-        /* Regular (not aggregate) handles merely store the target for future flushing. */
-        handle->target = proc;
-    }
+    /* COPY/SCALE: Free temp buffer once the handle completes */
+    if (src_buf != src_ptr)
+      ARMCII_Hdl_defer(handle, proc, src_buf, NULL, NULL, NULL, 0);
 
     err = 0;
 
   } else {
-    armci_giov_t iov;
-
-    ARMCII_Strided_to_iov(&iov, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar, count, stride_levels);
-    err = PARMCI_NbAccV(datatype, scale, &iov, 1, proc, handle);
-
-    free(iov.src_ptr_array);
-    free(iov.dst_ptr_array);
+    err = ARMCII_Strided_iov_op(ARMCII_OP_ACC, datatype, scale, src_ptr, src_stride_ar, dst_ptr, dst_stride_ar,
+                                count, stride_levels, proc, 0 /* nonblocking */, handle);
   }
 
   gmr_progress();
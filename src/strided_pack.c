@@ -0,0 +1,329 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <armci.h>
+#include <armci_internals.h>
+#include <debug.h>
+
+#ifdef ARMCII_X86_SIMD
+#  include <immintrin.h>
+#endif
+
+/** Strided pack/unpack engine.  Packing copies a strided patch into a
+  * contiguous buffer and unpacking copies it back out; both are a copy
+  * between two strided layouts, one of which happens to be dense.
+  *
+  * Patches with up to three levels of striding are copied by dedicated loop
+  * nests and deeper patches recurse down to them.  The innermost loop is
+  * specialized for blocks of 8, 16, 32 and 64 bytes and for multiples of the
+  * cache line so the compiler can emit fixed size moves.  When the
+  * destination is larger than ARMCI_PACK_NT_THRESHOLD, whole cache lines are
+  * written with non-temporal stores so that a large pack does not evict the
+  * caller's working set.  Patches large enough to keep ARMCI_PACK_THREADS
+  * threads busy are split along their outermost dimension.
+  */
+
+#define PACK_CACHE_LINE   64
+#define PACK_MT_MIN_BYTES (1024*1024) /* Smallest share of a patch given to one thread */
+
+
+/* -- Block copies -- */
+
+#ifdef ARMCII_X86_SIMD
+/** Copy n bytes, writing whole 16 byte lines of the destination with
+  * non-temporal stores.  The caller must issue pack_nt_fence() before the
+  * destination is read by anyone else.
+  */
+__attribute__((target("sse2")))
+static void pack_copy_nt(uint8_t *dst, const uint8_t *src, size_t n) {
+  size_t head = (16 - ((uintptr_t) dst & 15)) & 15;
+
+  if (head > n) head = n;
+  memcpy(dst, src, head);
+  dst += head; src += head; n -= head;
+
+  for (; n >= 64; n -= 64, dst += 64, src += 64) {
+    __m128i a = _mm_loadu_si128((const __m128i*) src);
+    __m128i b = _mm_loadu_si128((const __m128i*) (src + 16));
+    __m128i c = _mm_loadu_si128((const __m128i*) (src + 32));
+    __m128i d = _mm_loadu_si128((const __m128i*) (src + 48));
+    _mm_stream_si128((__m128i*) dst, a);
+    _mm_stream_si128((__m128i*) (dst + 16), b);
+    _mm_stream_si128((__m128i*) (dst + 32), c);
+    _mm_stream_si128((__m128i*) (dst + 48), d);
+  }
+
+  for (; n >= 16; n -= 16, dst += 16, src += 16)
+    _mm_stream_si128((__m128i*) dst, _mm_loadu_si128((const __m128i*) src));
+
+  memcpy(dst, src, n);
+}
+
+__attribute__((target("sse2")))
+static void pack_nt_fence(void) {
+  _mm_sfence();
+}
+#else
+#  define pack_copy_nt(dst_, src_, n_) memcpy(dst_, src_, n_)
+#  define pack_nt_fence()
+#endif
+
+
+/** Copy rows blocks of bytes each from src to dst.  Constant sizes let the
+  * compiler replace memcpy with a few moves.
+  */
+#define PACK_ROWS_FIXED(SIZE)                                                   \
+  for (r = 0; r < rows; r++, dst += dst_stride, src += src_stride)              \
+    memcpy(dst, src, SIZE)
+
+static inline void pack_rows(uint8_t *dst, const uint8_t *src, int bytes, int rows,
+                             ptrdiff_t dst_stride, ptrdiff_t src_stride, int nt) {
+  int r, k;
+
+  if (nt && bytes >= PACK_CACHE_LINE) {
+    for (r = 0; r < rows; r++, dst += dst_stride, src += src_stride)
+      pack_copy_nt(dst, src, bytes);
+    return;
+  }
+
+  switch (bytes) {
+    case 8:  PACK_ROWS_FIXED(8);  break;
+    case 16: PACK_ROWS_FIXED(16); break;
+    case 32: PACK_ROWS_FIXED(32); break;
+    case 64: PACK_ROWS_FIXED(64); break;
+    default:
+      if (bytes % PACK_CACHE_LINE == 0) {
+        for (r = 0; r < rows; r++, dst += dst_stride, src += src_stride)
+          for (k = 0; k < bytes; k += PACK_CACHE_LINE)
+            memcpy(dst + k, src + k, PACK_CACHE_LINE);
+      } else {
+        for (r = 0; r < rows; r++, dst += dst_stride, src += src_stride)
+          memcpy(dst, src, bytes);
+      }
+  }
+}
+
+#undef PACK_ROWS_FIXED
+
+
+/* -- Loop nests -- */
+
+/** Copy a patch between two strided layouts.
+  *
+  * @param[in] dst           Destination base
+  * @param[in] dst_stride    Destination strides (stride_levels entries)
+  * @param[in] src           Source base
+  * @param[in] src_stride    Source strides (stride_levels entries)
+  * @param[in] count         Counts (stride_levels+1 entries, count[0] in bytes)
+  * @param[in] stride_levels Number of levels of striding
+  * @param[in] nt            Use non-temporal stores
+  */
+static void pack_levels(uint8_t *dst, const ptrdiff_t dst_stride[], const uint8_t *src,
+                        const ptrdiff_t src_stride[], const int count[], int stride_levels, int nt) {
+  int i, j;
+
+  switch (stride_levels) {
+    case 0:
+      if (nt) pack_copy_nt(dst, src, count[0]);
+      else    memcpy(dst, src, count[0]);
+      break;
+
+    case 1:
+      pack_rows(dst, src, count[0], count[1], dst_stride[0], src_stride[0], nt);
+      break;
+
+    case 2:
+      for (j = 0; j < count[2]; j++)
+        pack_rows(dst + j*dst_stride[1], src + j*src_stride[1],
+                  count[0], count[1], dst_stride[0], src_stride[0], nt);
+      break;
+
+    case 3:
+      for (i = 0; i < count[3]; i++) {
+        uint8_t       *d = dst + i*dst_stride[2];
+        const uint8_t *s = src + i*src_stride[2];
+
+        for (j = 0; j < count[2]; j++)
+          pack_rows(d + j*dst_stride[1], s + j*src_stride[1],
+                    count[0], count[1], dst_stride[0], src_stride[0], nt);
+      }
+      break;
+
+    default:
+      for (j = 0; j < count[stride_levels]; j++)
+        pack_levels(dst + j*dst_stride[stride_levels-1], dst_stride,
+                    src + j*src_stride[stride_levels-1], src_stride,
+                    count, stride_levels-1, nt);
+  }
+}
+
+
+/* -- Threaded packing -- */
+
+typedef struct {
+  uint8_t         *dst;
+  const ptrdiff_t *dst_stride;
+  const uint8_t   *src;
+  const ptrdiff_t *src_stride;
+  const int       *count;
+  int              stride_levels;
+  int              nt;
+  int              lo, hi;       /* Range of the outermost index copied */
+} pack_task_t;
+
+static void *pack_task_run(void *arg) {
+  pack_task_t *t = (pack_task_t*) arg;
+  const int    outer = t->stride_levels-1;
+  int j;
+
+  for (j = t->lo; j < t->hi; j++)
+    pack_levels(t->dst + j*t->dst_stride[outer], t->dst_stride,
+                t->src + j*t->src_stride[outer], t->src_stride,
+                t->count, outer, t->nt);
+
+  if (t->nt) pack_nt_fence();
+
+  return NULL;
+}
+
+
+/** Number of threads to use for a patch of the given size.
+  */
+static int pack_nthreads(size_t bytes, const int count[], int stride_levels) {
+#ifdef HAVE_PTHREADS
+  size_t nthreads = ARMCII_GLOBAL_STATE.pack_threads;
+
+  if (nthreads <= 1 || stride_levels == 0)
+    return 1;
+
+  if (nthreads > bytes / PACK_MT_MIN_BYTES)
+    nthreads = bytes / PACK_MT_MIN_BYTES;
+  if (nthreads > (size_t) count[stride_levels])
+    nthreads = count[stride_levels];
+
+  return nthreads > 1 ? nthreads : 1;
+#else
+  return 1;
+#endif
+}
+
+
+/** Copy a patch, splitting it among threads if it is large enough.
+  */
+static void pack_engine(uint8_t *dst, const ptrdiff_t dst_stride[], const uint8_t *src,
+                        const ptrdiff_t src_stride[], const int count[], int stride_levels) {
+  size_t bytes = count[0];
+  int    i, nt, nthreads;
+
+  for (i = 1; i <= stride_levels; i++)
+    bytes *= count[i];
+
+  if (bytes == 0)
+    return;
+
+  nt = ARMCII_GLOBAL_STATE.pack_nt_threshold > 0 &&
+       bytes >= (size_t) ARMCII_GLOBAL_STATE.pack_nt_threshold;
+
+  nthreads = pack_nthreads(bytes, count, stride_levels);
+
+#ifdef HAVE_PTHREADS
+  if (nthreads > 1) {
+    pthread_t   threads[nthreads];
+    pack_task_t tasks[nthreads];
+    const int   outer = count[stride_levels];
+
+    for (i = 0; i < nthreads; i++) {
+      tasks[i].dst           = dst;
+      tasks[i].dst_stride    = dst_stride;
+      tasks[i].src           = src;
+      tasks[i].src_stride    = src_stride;
+      tasks[i].count         = count;
+      tasks[i].stride_levels = stride_levels;
+      tasks[i].nt            = nt;
+      tasks[i].lo            = (int) (((size_t) outer * i) / nthreads);
+      tasks[i].hi            = (int) (((size_t) outer * (i+1)) / nthreads);
+    }
+
+    /* The calling thread takes the first share */
+    for (i = 1; i < nthreads; i++) {
+      if (pthread_create(&threads[i], NULL, pack_task_run, &tasks[i]) != 0) {
+        /* Could not start a helper; do its share here */
+        pack_task_run(&tasks[i]);
+        threads[i] = pthread_self();
+      }
+    }
+
+    pack_task_run(&tasks[0]);
+
+    for (i = 1; i < nthreads; i++)
+      if (!pthread_equal(threads[i], pthread_self()))
+        pthread_join(threads[i], NULL);
+
+    return;
+  }
+#else
+  (void) nthreads;
+#endif
+
+  pack_levels(dst, dst_stride, src, src_stride, count, stride_levels, nt);
+
+  if (nt) pack_nt_fence();
+}
+
+
+/** Strides of a dense buffer holding a patch with the given counts.
+  */
+static void pack_dense_strides(ptrdiff_t stride[], const int count[], int stride_levels) {
+  int i;
+
+  if (stride_levels > 0)
+    stride[0] = count[0];
+
+  for (i = 1; i < stride_levels; i++)
+    stride[i] = stride[i-1] * count[i];
+}
+
+
+/** Pack a strided patch into a contiguous buffer.
+  *
+  * @param[in]  src           Strided source buffer
+  * @param[in]  src_stride_ar Source strides in bytes (stride_levels entries)
+  * @param[in]  count         Counts (stride_levels+1 entries, count[0] in bytes)
+  * @param[in]  stride_levels Number of levels of striding
+  * @param[out] dst           Contiguous destination buffer
+  */
+void ARMCII_Pack_strided(void *src, int src_stride_ar[], int count[], int stride_levels, void *dst) {
+  ptrdiff_t src_stride[stride_levels+1], dst_stride[stride_levels+1];
+  int i;
+
+  for (i = 0; i < stride_levels; i++)
+    src_stride[i] = src_stride_ar[i];
+
+  pack_dense_strides(dst_stride, count, stride_levels);
+  pack_engine(dst, dst_stride, src, src_stride, count, stride_levels);
+}
+
+
+/** Unpack a contiguous buffer into a strided patch.
+  *
+  * @param[in]  src           Contiguous source buffer
+  * @param[out] dst           Strided destination buffer
+  * @param[in]  dst_stride_ar Destination strides in bytes (stride_levels entries)
+  * @param[in]  count         Counts (stride_levels+1 entries, count[0] in bytes)
+  * @param[in]  stride_levels Number of levels of striding
+  */
+void ARMCII_Unpack_strided(void *src, void *dst, int dst_stride_ar[], int count[], int stride_levels) {
+  ptrdiff_t src_stride[stride_levels+1], dst_stride[stride_levels+1];
+  int i;
+
+  for (i = 0; i < stride_levels; i++)
+    dst_stride[i] = dst_stride_ar[i];
+
+  pack_dense_strides(src_stride, count, stride_levels);
+  pack_engine(dst, dst_stride, src, src_stride, count, stride_levels);
+}
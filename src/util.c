@@ -40,8 +40,10 @@ void PARMCI_Barrier(void) {
   gmr_t *cur_mreg = gmr_list;
 
   PARMCI_AllFence();
-  MPI_Barrier(ARMCI_GROUP_WORLD.comm);
+  gmr_barrier();
 
+  /* Processes may have stored directly into their own slices, so windows are
+   * synchronized even if no RMA was issued */
   while (cur_mreg) {
     gmr_sync(cur_mreg);
     cur_mreg = cur_mreg->next;
@@ -60,17 +62,20 @@ void PARMCI_Barrier(void) {
 
 /** Wait for remote completion on one-sided operations targeting process proc.
   * In MPI-2, this is a no-op since get/put/acc already guarantee remote
-  * completion.
+  * completion.  Only windows with outstanding operations are flushed.
   *
   * @param[in] proc Process to target
   */
 void PARMCI_Fence(int proc) {
-  gmr_t *cur_mreg = gmr_list;
+  gmr_t *cur_mreg = gmr_dirty_list;
 
   while (cur_mreg) {
+    gmr_t *next = cur_mreg->dirty_next; /* flushing can unlink cur_mreg */
     gmr_flush(cur_mreg, proc, 0);
-    cur_mreg = cur_mreg->next;
+    cur_mreg = next;
   }
+
+  ARMCII_Hdl_retire_implicit(proc);
   return;
 }
 
@@ -89,12 +94,15 @@ void PARMCI_Fence(int proc) {
   * a no-op since get/put/acc already guarantee remote completion.
   */
 void PARMCI_AllFence(void) {
-  gmr_t *cur_mreg = gmr_list;
+  gmr_t *cur_mreg = gmr_dirty_list;
 
   while (cur_mreg) {
+    gmr_t *next = cur_mreg->dirty_next; /* flushing unlinks cur_mreg */
     gmr_flushall(cur_mreg, 0);
-    cur_mreg = cur_mreg->next;
+    cur_mreg = next;
   }
+
+  ARMCII_Hdl_retire_implicit(-1);
   return;
 }
 
@@ -4,108 +4,315 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <limits.h>
 
 #include <armci.h>
+#include <armcix.h>
 #include <armci_internals.h>
 #include <debug.h>
 #include <gmr.h>
 
-#ifndef NO_USE_CTREE
-#include <conflict_tree.h>
-#endif
+#define IOV_DATATYPE_MAX_BLOCKS 8192 /* Most blocks described by one indexed type */
 
+#define IOV_PROBE_REPS       5     /* Timed repetitions of each calibration probe */
+#define IOV_PROBE_NPOINTS    10    /* Counts (sizes) tried by each probe          */
+#define IOV_PROBE_COUNT_MAX  1024  /* Largest block count tried                   */
+#define IOV_PROBE_BLOCK      64    /* Block size for the count probe              */
+#define IOV_PROBE_SIZE_COUNT 32    /* Block count for the size probe              */
+#define IOV_PROBE_SIZE_MAX   32768 /* Largest block size tried                    */
+#define IOV_PROBE_BYTES      (2*IOV_PROBE_SIZE_COUNT*IOV_PROBE_SIZE_MAX)
 
-/** Check an I/O vector operation's buffers for overlap.
+
+/** An address range [lo, hi] checked for overlap.
+  */
+typedef struct {
+  uint8_t *lo;
+  uint8_t *hi;
+} iov_range_t;
+
+
+static int iov_range_cmp(const void *a, const void *b) {
+  const iov_range_t *x = a, *y = b;
+  return (x->lo > y->lo) - (x->lo < y->lo);
+}
+
+
+/** Check an I/O vector operation's buffers for overlap.  The ranges are
+  * sorted by their low address in a scratch array (callers usually pass
+  * them in order already, which is detected) and overlap is found in one
+  * sweep.
   *
-  * @param[in] iov      Vector of transfer information.
+  * @param[in] ptrs     Array of count buffers
+  * @param[in] count    Number of buffers
+  * @param[in] size     Size of every buffer, when sizes is NULL
+  * @param[in] sizes    Size of each buffer, or NULL
   * @return             Logical true when regions overlap, 0 otherwise.
   */
-int ARMCII_Iov_check_overlap(void **ptrs, int count, int size) {
+static int ARMCII_Iov_check_overlap_sizes(void **ptrs, int count, int size, int sizes[]) {
 #ifndef NO_CHECK_OVERLAP
-#ifdef NO_USE_CTREE
-  int i, j;
+  iov_range_t *ranges;
+  uint8_t     *hi_max;
+  int          i, sorted = 1, overlap = 0;
 
-  if (!ARMCII_GLOBAL_STATE.iov_checks) return 0;
+  if (!ARMCII_GLOBAL_STATE.iov_checks || count < 2) return 0;
 
-  for (i = 0; i < count; i++) {
-    for (j = i+1; j < count; j++) {
-      const uint8_t *ptr_1_lo = ptrs[i];
-      const uint8_t *ptr_1_hi = ((uint8_t*)ptrs[i]) + size - 1;
-      const uint8_t *ptr_2_lo = ptrs[j];
-      const uint8_t *ptr_2_hi = ((uint8_t*)ptrs[j]) + size - 1;
-
-      if (   (ptr_1_lo >= ptr_2_lo && ptr_1_lo <= ptr_2_hi)
-          || (ptr_1_hi >= ptr_2_lo && ptr_1_hi <= ptr_2_hi)
-          || (ptr_1_lo <  ptr_2_lo && ptr_1_hi >  ptr_2_hi)) {
-        ARMCII_Dbg_print(DEBUG_CAT_IOV, "IOV regions overlap: [%p, %p] - [%p, %p]\n",
-            ptr_1_lo, ptr_1_hi, ptr_2_lo, ptr_2_hi);
-        return 1;
-      }
-    }
-  }
-#else
-  int i;
-  ctree_t ctree = CTREE_EMPTY;
-
-  if (!ARMCII_GLOBAL_STATE.iov_checks) return 0;
+  ranges = ARMCII_Scratch_get(sizeof(iov_range_t)*count);
+  ARMCII_Assert(ranges != NULL);
 
   for (i = 0; i < count; i++) {
-    int conflict = ctree_insert(&ctree, ptrs[i], ((uint8_t*)ptrs[i]) + size - 1);
+    ranges[i].lo = ptrs[i];
+    ranges[i].hi = ((uint8_t*)ptrs[i]) + (sizes ? sizes[i] : size) - 1;
+    sorted       = sorted && (i == 0 || ranges[i-1].lo <= ranges[i].lo);
+  }
 
-    if (conflict) {
-      ctree_t cnode = ctree_locate(ctree, ptrs[i], ((uint8_t*)ptrs[i]) + size - 1);
+  if (!sorted)
+    qsort(ranges, count, sizeof(iov_range_t), iov_range_cmp);
 
+  for (i = 1, hi_max = ranges[0].hi; i < count; i++) {
+    if (ranges[i].lo <= hi_max) {
       ARMCII_Dbg_print(DEBUG_CAT_IOV, "IOV regions overlap: [%p, %p] - [%p, %p]\n",
-          ptrs[i], ((uint8_t*)ptrs[i]) + size - 1, cnode->lo, cnode->hi);
-
-      ctree_destroy(&ctree);
-      return 1;
+          ranges[i-1].lo, ranges[i-1].hi, ranges[i].lo, ranges[i].hi);
+      overlap = 1;
+      break;
     }
+
+    if (ranges[i].hi > hi_max)
+      hi_max = ranges[i].hi;
   }
 
-  ctree_destroy(&ctree);
-#endif /* NO_USE_CTREE */
-#endif /* NO_CHECK_OVERLAP */
+  ARMCII_Scratch_put(ranges);
 
+  return overlap;
+#else
   return 0;
+#endif /* NO_CHECK_OVERLAP */
 }
 
 
-/** Check if a set of pointers all corresponds to the same allocation.
+/** Check an I/O vector operation's buffers for overlap.
+  *
+  * @param[in] ptrs     Array of count buffers
+  * @param[in] count    Number of buffers
+  * @param[in] size     Size of each buffer
+  * @return             Logical true when regions overlap, 0 otherwise.
+  */
+int ARMCII_Iov_check_overlap(void **ptrs, int count, int size) {
+  return ARMCII_Iov_check_overlap_sizes(ptrs, count, size, NULL);
+}
+
+
+/** Check if a set of blocks all corresponds to the same allocation.  The
+  * region holding the lowest block is looked up once and the span of all
+  * blocks is checked against its bounds.
   *
   * @param[in] ptrs  An array of count shared pointers valid on proc.
   * @param[in] count Size of the ptrs array.
+  * @param[in] size  Size of every block, when sizes is NULL.
+  * @param[in] sizes Size of each block, or NULL.
   * @param[in] proc  Process on which the pointers are valid.
   * @return          Non-zero (true) on success, zero (false) otherwise.
   */
-int ARMCII_Iov_check_same_allocation(void **ptrs, int count, int proc) {
-  int i;
+static int ARMCII_Iov_check_same_allocation_sizes(void **ptrs, int count, int size, int sizes[], int proc) {
+  int i, i_lo = 0;
   gmr_t *mreg;
-  void *base, *extent;
+  uint8_t *lo, *hi, *base;
 
   if (!ARMCII_GLOBAL_STATE.iov_checks) return 1;
 
-  mreg = gmr_lookup(ptrs[0], proc);
+  lo = ptrs[0];
+  hi = ((uint8_t*)ptrs[0]) + (sizes ? sizes[0] : size);
+
+  for (i = 1; i < count; i++) {
+    uint8_t *end = ((uint8_t*)ptrs[i]) + (sizes ? sizes[i] : size);
+
+    if ((uint8_t*)ptrs[i] < lo) {
+      lo   = ptrs[i];
+      i_lo = i;
+    }
+    if (end > hi) hi = end;
+  }
+
+  mreg = gmr_lookup(lo, proc);
 
   /* If local, all must be local */
   if (mreg == NULL) {
-    for (i = 1; i < count; i++) {
+    for (i = 0; i < count; i++) {
+      if (i == i_lo) continue;
+
       mreg = gmr_lookup(ptrs[i], proc);
       if (mreg != NULL)
         return 0;
     }
+
+    return 1;
   }
+
   /* If shared, all must fall in this region */
-  else {
-    base   = mreg->slices[proc].base;
-    extent = ((uint8_t*) base) + mreg->slices[proc].size;
+  base = mreg->slices[proc].base;
 
-    for (i = 1; i < count; i++)
-      if ( !(ptrs[i] >= base && ptrs[i] < extent) )
-        return 0;
+  return hi <= base + mreg->slices[proc].size;
+}
+
+
+/** Check if a set of pointers all corresponds to the same allocation.
+  *
+  * @param[in] ptrs  An array of count shared pointers valid on proc.
+  * @param[in] count Size of the ptrs array.
+  * @param[in] proc  Process on which the pointers are valid.
+  * @return          Non-zero (true) on success, zero (false) otherwise.
+  */
+int ARMCII_Iov_check_same_allocation(void **ptrs, int count, int proc) {
+  return ARMCII_Iov_check_same_allocation_sizes(ptrs, count, 1, NULL, proc);
+}
+
+
+/** One block of an I/O vector operation.
+  */
+typedef struct {
+  uint8_t *src;
+  uint8_t *dst;
+  int      len;   /* Elements of the operation's datatype */
+} iov_seg_t;
+
+
+static int iov_seg_cmp_dst(const void *a, const void *b) {
+  const iov_seg_t *x = a, *y = b;
+  return (x->dst > y->dst) - (x->dst < y->dst);
+}
+
+
+static int iov_seg_cmp_src(const void *a, const void *b) {
+  const iov_seg_t *x = a, *y = b;
+  return (x->src > y->src) - (x->src < y->src);
+}
+
+
+/** Sort the blocks of an I/O vector operation by remote address and merge
+  * blocks that are contiguous on both the local and the remote side.
+  *
+  * @param[inout] segs      Blocks of the operation
+  * @param[in]    count     Number of blocks
+  * @param[in]    op        Operation (selects the remote side)
+  * @param[in]    type_size Size of the operation's datatype
+  * @return                 Number of blocks after merging
+  */
+static int ARMCII_Iov_coalesce(iov_seg_t *segs, int count, enum ARMCII_Op_e op, int type_size) {
+  int (*cmp)(const void *, const void *) = (op == ARMCII_OP_GET) ? iov_seg_cmp_src : iov_seg_cmp_dst;
+  int i, n, sorted = 1;
+
+  for (i = 1; i < count && sorted; i++)
+    sorted = cmp(&segs[i-1], &segs[i]) <= 0;
+
+  if (!sorted)
+    qsort(segs, count, sizeof(iov_seg_t), cmp);
+
+  for (i = 1, n = 0; i < count; i++) {
+    const armci_size_t bytes = (armci_size_t) segs[n].len * type_size;
+
+    if (   segs[n].src + bytes == segs[i].src
+        && segs[n].dst + bytes == segs[i].dst
+        && (armci_size_t) segs[n].len + segs[i].len <= INT_MAX / type_size)
+      segs[n].len += segs[i].len;
+    else
+      segs[++n] = segs[i];
   }
 
-  return 1;
+  return n+1;
+}
+
+
+/** Choose between the datatype and batched methods in AUTO mode.  Many
+  * small blocks are cheaper to describe with one datatype; a few large
+  * blocks are cheaper to issue as separate operations.
+  *
+  * @param[in] segs      Blocks of the operation
+  * @param[in] count     Number of blocks
+  * @param[in] type_size Size of the element type
+  * @return              Non-zero if the datatype method should be used
+  */
+static int ARMCII_Iov_auto_use_datatype(iov_seg_t *segs, int count, int type_size) {
+  armci_size_t bytes = 0;
+  int i;
+
+  if (   count < ARMCII_GLOBAL_STATE.iov_auto_min_count
+      || ARMCII_GLOBAL_STATE.iov_auto_max_size == 0)
+    return 0;
+
+  for (i = 0; i < count; i++)
+    bytes += (armci_size_t) segs[i].len * type_size;
+
+  return bytes <= (armci_size_t) count * ARMCII_GLOBAL_STATE.iov_auto_max_size;
+}
+
+
+/** Issue the blocks of an I/O vector operation with the selected method.
+  * Local buffers must be private.
+  *
+  * @param[in] op          Operation to be performed (ARMCII_OP_PUT, ...)
+  * @param[in] segs        Blocks of the operation (reordered on return)
+  * @param[in] count       Number of blocks
+  * @param[in] type        Element type
+  * @param[in] type_size   Size of the element type
+  * @param[in] consrv      Use the conservative method
+  * @param[in] proc        Target process
+  * @param[in] blocking    Complete the operation before returning
+  * @return                Zero on success, error code otherwise
+  */
+static int ARMCII_Iov_op_segs(enum ARMCII_Op_e op, iov_seg_t *segs, int count, MPI_Datatype type,
+    int type_size, int consrv, int proc, int blocking) {
+
+  int    i, ret;
+  void **seg_src, **seg_dst;
+  int   *seg_len;
+
+  // Blocks issued in the same epoch may complete in any order, so the
+  // optimized methods can reorder and merge them.  Overlapping blocks are
+  // left in the caller's order.
+
+  if (!consrv && ARMCII_GLOBAL_STATE.iov_coalesce)
+    count = ARMCII_Iov_coalesce(segs, count, op, type_size);
+
+  seg_src = ARMCII_Scratch_get((2*sizeof(void*) + sizeof(int))*count);
+  ARMCII_Assert(seg_src != NULL);
+
+  seg_dst = seg_src + count;
+  seg_len = (int*) (seg_dst + count);
+
+  for (i = 0; i < count; i++) {
+    seg_src[i] = segs[i].src;
+    seg_dst[i] = segs[i].dst;
+    seg_len[i] = segs[i].len;
+  }
+
+  if (consrv) {
+#if 0
+    ret = ARMCII_Iov_op_safe(op, seg_src, seg_dst, count, seg_len, type, proc);
+#else
+    /* Jeff: We are going to always block when there is buffer overlap. */
+    ret = ARMCII_Iov_op_batched(op, seg_src, seg_dst, count, seg_len, type, proc, 1 /* consrv */, 1 /* blocking */);
+#endif
+  }
+
+  // OPTIMIZED CASE: It's safe for us to issue all the operations under a
+  // single lock.
+
+  else if (   ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_DIRECT
+           || (   ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_AUTO
+               && ARMCII_Iov_auto_use_datatype(segs, count, type_size))) {
+    ret = ARMCII_Iov_op_datatype(op, seg_src, seg_dst, count, seg_len, type, proc, blocking);
+
+  } else if (   ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_BATCHED
+             || ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_AUTO) {
+    ret = ARMCII_Iov_op_batched(op, seg_src, seg_dst, count, seg_len, type, proc, 0 /* not consrv */, blocking);
+
+  } else {
+    ARMCII_Error("unknown iov method (%d)\n", ARMCII_GLOBAL_STATE.iov_method);
+    ret = 1;
+  }
+
+  ARMCII_Scratch_put(seg_src);
+
+  return ret;
 }
 
 
@@ -126,7 +333,8 @@ int ARMCII_Iov_op_dispatch(enum ARMCII_Op_e op, void **src, void **dst, int coun
     int datatype, int overlapping, int same_alloc, int proc, int blocking) {
 
   MPI_Datatype type;
-  int type_count, type_size;
+  int type_count, type_size, consrv, i, ret;
+  iov_seg_t *segs;
 
   if (op == ARMCII_OP_ACC) {
     ARMCII_Acc_type_translate(datatype, &type, &type_size);
@@ -143,37 +351,125 @@ int ARMCII_Iov_op_dispatch(enum ARMCII_Op_e op, void **src, void **dst, int coun
   // multiple allocations, use the safe implementation to avoid invalid MPI
   // use.
 
-  if (overlapping || !same_alloc || ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_CONSRV) {
+  consrv = overlapping || !same_alloc || ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_CONSRV;
+
+  if (consrv) {
     if (overlapping) ARMCII_Warning("IOV remote buffers overlap\n");
     if (!same_alloc) ARMCII_Warning("IOV remote buffers are not within the same allocation\n");
-#if 0
-    return ARMCII_Iov_op_safe(op, src, dst, count, type_count, type, proc);
-#else
-    /* Jeff: We are going to always block when there is buffer overlap. */
-    return ARMCII_Iov_op_batched(op, src, dst, count, type_count, type, proc, 1 /* consrv */, 1 /* blocking */);
-#endif
   }
 
-  // OPTIMIZED CASE: It's safe for us to issue all the operations under a
-  // single lock.
+  segs = ARMCII_Scratch_get(sizeof(iov_seg_t)*count);
+  ARMCII_Assert(segs != NULL);
 
-  else if (   ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_DIRECT
-           || ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_AUTO  ) {
-    return ARMCII_Iov_op_datatype(op, src, dst, count, type_count, type, proc, blocking);
+  for (i = 0; i < count; i++) {
+    segs[i].src = src[i];
+    segs[i].dst = dst[i];
+    segs[i].len = type_count;
+  }
 
-  } else if (ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_BATCHED) {
-    return ARMCII_Iov_op_batched(op, src, dst, count, type_count, type, proc, 0 /* not consrv */, blocking);
+  ret = ARMCII_Iov_op_segs(op, segs, count, type, type_size, consrv, proc, blocking);
 
-  } else {
-    ARMCII_Error("unknown iov method (%d)\n", ARMCII_GLOBAL_STATE.iov_method);
-    return 1;
+  ARMCII_Scratch_put(segs);
+
+  return ret;
+}
+
+/** Time one blocking put of evenly spaced blocks with the given method.
+  * Blocks are one block apart on both sides so that they are not merged.
+  *
+  * @return Shortest time of IOV_PROBE_REPS repetitions, after a warm-up
+  */
+static double ARMCII_Iov_probe(int use_datatype, uint8_t *loc, uint8_t *rem, int count, int bytes,
+    int proc, void **src, void **dst, int *len) {
+
+  double best = 0.0, t;
+  int    i, r;
+
+  for (i = 0; i < count; i++) {
+    src[i] = loc + 2*i*bytes;
+    dst[i] = rem + 2*i*bytes;
+    len[i] = bytes;
   }
+
+  for (r = 0; r <= IOV_PROBE_REPS; r++) {
+    t = MPI_Wtime();
+
+    if (use_datatype)
+      ARMCII_Iov_op_datatype(ARMCII_OP_PUT, src, dst, count, len, MPI_BYTE, proc, 1);
+    else
+      ARMCII_Iov_op_batched(ARMCII_OP_PUT, src, dst, count, len, MPI_BYTE, proc, 0, 1);
+
+    t = MPI_Wtime() - t;
+
+    if (r == 1 || (r > 1 && t < best))
+      best = t;
+  }
+
+  return best;
 }
 
+
+/** Set the AUTO IOV method thresholds by timing both methods on puts to the
+  * next process.  The block count at which datatypes start to win is found
+  * with small blocks, and the block size up to which they keep winning with
+  * IOV_PROBE_SIZE_COUNT blocks.  Times are reduced over all processes so that
+  * every process picks the same thresholds.  Collective on the world group.
+  */
+void ARMCII_Iov_auto_calibrate(void) {
+  const int rank = ARMCI_GROUP_WORLD.rank;
+  const int proc = (rank+1) % ARMCI_GROUP_WORLD.size;
+  double    t[2][2][IOV_PROBE_NPOINTS]; /* [count/size probe][batched/datatype][point] */
+  void    **base_ptrs, **src, **dst;
+  uint8_t  *loc;
+  int      *len, k;
+
+  base_ptrs = malloc(sizeof(void*)*ARMCI_GROUP_WORLD.size);
+  src       = malloc(sizeof(void*)*IOV_PROBE_COUNT_MAX);
+  dst       = malloc(sizeof(void*)*IOV_PROBE_COUNT_MAX);
+  len       = malloc(sizeof(int)*IOV_PROBE_COUNT_MAX);
+  loc       = calloc(IOV_PROBE_BYTES, 1);
+  ARMCII_Assert(base_ptrs != NULL && src != NULL && dst != NULL && len != NULL && loc != NULL);
+
+  ARMCI_Malloc_group(base_ptrs, IOV_PROBE_BYTES, &ARMCI_GROUP_WORLD);
+
+  for (k = 0; k < IOV_PROBE_NPOINTS; k++) {
+    t[0][0][k] = ARMCII_Iov_probe(0, loc, base_ptrs[proc], IOV_PROBE_COUNT_MAX >> k, IOV_PROBE_BLOCK, proc, src, dst, len);
+    t[0][1][k] = ARMCII_Iov_probe(1, loc, base_ptrs[proc], IOV_PROBE_COUNT_MAX >> k, IOV_PROBE_BLOCK, proc, src, dst, len);
+    t[1][0][k] = ARMCII_Iov_probe(0, loc, base_ptrs[proc], IOV_PROBE_SIZE_COUNT, IOV_PROBE_SIZE_MAX >> k, proc, src, dst, len);
+    t[1][1][k] = ARMCII_Iov_probe(1, loc, base_ptrs[proc], IOV_PROBE_SIZE_COUNT, IOV_PROBE_SIZE_MAX >> k, proc, src, dst, len);
+  }
+
+  MPI_Allreduce(MPI_IN_PLACE, t, 4*IOV_PROBE_NPOINTS, MPI_DOUBLE, MPI_MAX, ARMCI_GROUP_WORLD.comm);
+
+  /* Points run from the largest count (size) to the smallest; keep the last
+   * one of the leading run where datatypes win */
+
+  for (k = 0; k < IOV_PROBE_NPOINTS && t[0][1][k] < t[0][0][k]; k++)
+    ARMCII_GLOBAL_STATE.iov_auto_min_count = IOV_PROBE_COUNT_MAX >> k;
+
+  if (k == 0)
+    ARMCII_GLOBAL_STATE.iov_auto_max_size = 0; /* Datatypes never won */
+  else {
+    ARMCII_GLOBAL_STATE.iov_auto_max_size = IOV_PROBE_BLOCK;
+
+    for (k = IOV_PROBE_NPOINTS-1; k >= 0 && t[1][1][k] < t[1][0][k]; k--)
+      ARMCII_GLOBAL_STATE.iov_auto_max_size = IOV_PROBE_SIZE_MAX >> k;
+  }
+
+  ARMCI_Free_group(base_ptrs[rank], &ARMCI_GROUP_WORLD);
+
+  free(base_ptrs);
+  free(src);
+  free(dst);
+  free(len);
+  free(loc);
+}
+
+
 #if 0
 /** Safe implementation of the ARMCI IOV operation
   */
-int ARMCII_Iov_op_safe(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count,
+int ARMCII_Iov_op_safe(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count[],
     MPI_Datatype type, int proc) {
 
   int i;
@@ -201,15 +497,15 @@ int ARMCII_Iov_op_safe(enum ARMCII_Op_e op, void **src, void **dst, int count, i
 
     switch(op) {
       case ARMCII_OP_PUT:
-        gmr_put(mreg, src[i], dst[i], elem_count, proc);
+        gmr_put(mreg, src[i], dst[i], elem_count[i], proc);
         flush_local = 1;
         break;
       case ARMCII_OP_GET:
-        gmr_get(mreg, src[i], dst[i], elem_count, proc);
+        gmr_get(mreg, src[i], dst[i], elem_count[i], proc);
         flush_local = 0;
         break;
       case ARMCII_OP_ACC:
-        gmr_accumulate(mreg, src[i], dst[i], elem_count, type, proc);
+        gmr_accumulate(mreg, src[i], dst[i], elem_count[i], type, proc);
         flush_local = 1;
         break;
       default:
@@ -227,7 +523,7 @@ int ARMCII_Iov_op_safe(enum ARMCII_Op_e op, void **src, void **dst, int count, i
 /** Optimized implementation of the ARMCI IOV operation that uses a single
   * lock/unlock pair.
   */
-int ARMCII_Iov_op_batched(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count,
+int ARMCII_Iov_op_batched(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count[],
     MPI_Datatype type, int proc, int consrv, int blocking) {
 
   int i;
@@ -264,15 +560,15 @@ int ARMCII_Iov_op_batched(enum ARMCII_Op_e op, void **src, void **dst, int count
 
     switch(op) {
       case ARMCII_OP_PUT:
-        gmr_put(mreg, src[i], dst[i], elem_count, proc);
+        gmr_put(mreg, src[i], dst[i], elem_count[i], proc);
         flush_local = 1;
         break;
       case ARMCII_OP_GET:
-        gmr_get(mreg, src[i], dst[i], elem_count, proc);
+        gmr_get(mreg, src[i], dst[i], elem_count[i], proc);
         flush_local = 0;
         break;
       case ARMCII_OP_ACC:
-        gmr_accumulate(mreg, src[i], dst[i], elem_count, type, proc);
+        gmr_accumulate(mreg, src[i], dst[i], elem_count[i], type, proc);
         flush_local = 1;
         break;
       default:
@@ -289,21 +585,74 @@ int ARMCII_Iov_op_batched(enum ARMCII_Op_e op, void **src, void **dst, int count
 }
 
 
+/** Check whether the blocks of an I/O vector are evenly spaced.
+  *
+  * @param[in]  ptrs   Array of count block addresses
+  * @param[in]  count  Number of blocks (at least two)
+  * @param[out] stride Distance in bytes between consecutive blocks
+  * @return            Non-zero if the distance is constant
+  */
+static int ARMCII_Iov_is_regular(void **ptrs, int count, MPI_Aint *stride) {
+  int i;
+
+  *stride = (uint8_t*) ptrs[1] - (uint8_t*) ptrs[0];
+
+  for (i = 2; i < count; i++)
+    if ((uint8_t*) ptrs[i] - (uint8_t*) ptrs[i-1] != *stride)
+      return 0;
+
+  return 1;
+}
+
+
+/** Issue one typed operation of the datatype IOV method.
+  *
+  * @return Non-zero if a local flush completes the operation
+  */
+static int ARMCII_Iov_op_typed(enum ARMCII_Op_e op, gmr_t *mreg, void *ptr_loc, MPI_Datatype type_loc,
+    void *ptr_rem, MPI_Datatype type_rem, int proc) {
+
+    MPI_Type_commit(&type_loc);
+    MPI_Type_commit(&type_rem);
+
+    switch(op) {
+      case ARMCII_OP_PUT:
+        gmr_put_typed(mreg, ptr_loc, 1, type_loc, ptr_rem, 1, type_rem, proc);
+        break;
+      case ARMCII_OP_GET:
+        gmr_get_typed(mreg, ptr_rem, 1, type_rem, ptr_loc, 1, type_loc, proc);
+        break;
+      case ARMCII_OP_ACC:
+        gmr_accumulate_typed(mreg, ptr_loc, 1, type_loc, ptr_rem, 1, type_rem, proc);
+        break;
+    }
+
+    /* Pending operations keep their own reference to the types */
+    MPI_Type_free(&type_loc);
+    MPI_Type_free(&type_rem);
+
+    return op != ARMCII_OP_GET;
+}
+
+
 /** Optimized implementation of the ARMCI IOV operation that uses an MPI
-  * datatype to achieve a one-sided gather/scatter.
+  * datatype to achieve a one-sided gather/scatter.  Blocks of one size that
+  * are evenly spaced on both sides, such as the columns of a matrix, are
+  * described with vector types relative to the first block.  Other vectors
+  * use indexed types of at most IOV_DATATYPE_MAX_BLOCKS blocks each, issued
+  * as separate operations, so that large vectors neither need large
+  * temporary arrays nor produce types that are slow to commit.
   */
-int ARMCII_Iov_op_datatype(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count,
+int ARMCII_Iov_op_datatype(enum ARMCII_Op_e op, void **src, void **dst, int count, int elem_count[],
     MPI_Datatype type, int proc, int blocking) {
 
     gmr_t *mreg;
     MPI_Datatype  type_loc, type_rem;
-    MPI_Aint      disp_loc[count];
-    int           disp_rem[count];
-    int           block_len[count];
+    MPI_Aint      stride_loc, stride_rem;
     void         *dst_win_base;
-    int           dst_win_size, i, type_size;
+    gmr_size_t    dst_win_size;
+    int           i, type_size, regular;
     void        **buf_rem, **buf_loc;
-    MPI_Aint      base_rem;
     int flush_local = 0; /* used only for MPI-3 */
 
     switch(op) {
@@ -329,55 +678,341 @@ int ARMCII_Iov_op_datatype(enum ARMCII_Op_e op, void **src, void **dst, int coun
     dst_win_base = mreg->slices[proc].base;
     dst_win_size = mreg->slices[proc].size;
 
-    MPI_Get_address(dst_win_base, &base_rem);
+    regular = count > 1;
+
+    for (i = 1; i < count && regular; i++)
+      regular = elem_count[i] == elem_count[0];
+
+    /* The remote type must not reach below the first block */
+    regular =    regular
+              && ARMCII_Iov_is_regular(buf_rem, count, &stride_rem) && stride_rem > 0
+              && ARMCII_Iov_is_regular(buf_loc, count, &stride_loc);
+
+    if (regular) {
+      ARMCII_Assert_msg(stride_rem % type_size == 0, "Transfer size is not a multiple of type size");
+      ARMCII_Assert_msg((uint8_t*)buf_rem[0] >= (uint8_t*)dst_win_base, "Invalid remote pointer");
+      ARMCII_Assert_msg(((uint8_t*)buf_rem[count-1]) + (armci_size_t) elem_count[0]*type_size
+                          <= ((uint8_t*)dst_win_base) + dst_win_size, "Transfer exceeds buffer length");
+
+      MPI_Type_create_hvector(count, elem_count[0], stride_loc, type, &type_loc);
+      MPI_Type_create_hvector(count, elem_count[0], stride_rem, type, &type_rem);
+
+      flush_local = ARMCII_Iov_op_typed(op, mreg, buf_loc[0], type_loc, buf_rem[0], type_rem, proc);
+
+    } else {
+      const int nblocks = (count < IOV_DATATYPE_MAX_BLOCKS) ? count : IOV_DATATYPE_MAX_BLOCKS;
+      MPI_Aint *disp_loc, *disp_rem, base_rem;
+      int       lo, n, uniform;
+
+      disp_loc = ARMCII_Scratch_get(2*sizeof(MPI_Aint)*nblocks);
+      ARMCII_Assert(disp_loc != NULL);
+      disp_rem = disp_loc + nblocks;
+
+      MPI_Get_address(dst_win_base, &base_rem);
+
+      for (lo = 0; lo < count; lo += n) {
+        n       = (count - lo < nblocks) ? count - lo : nblocks;
+        uniform = 1;
+
+        for (i = 0; i < n; i++) {
+          MPI_Aint target_rem;
+          MPI_Get_address(buf_loc[lo+i], &disp_loc[i]);
+          MPI_Get_address(buf_rem[lo+i], &target_rem);
+          disp_rem[i] = target_rem - base_rem;
+          uniform     = uniform && elem_count[lo+i] == elem_count[lo];
+
+          ARMCII_Assert_msg(disp_rem[i] % type_size == 0, "Transfer size is not a multiple of type size");
+          ARMCII_Assert_msg(disp_rem[i] >= 0 && disp_rem[i] < dst_win_size, "Invalid remote pointer");
+          ARMCII_Assert_msg(((uint8_t*)buf_rem[lo+i]) + (armci_size_t) elem_count[lo+i]*type_size
+                              <= ((uint8_t*)dst_win_base) + dst_win_size, "Transfer exceeds buffer length");
+        }
+
+        /* Byte displacements keep windows larger than 2 GiB addressable */
+        if (uniform) {
+          MPI_Type_create_hindexed_block(n, elem_count[lo], disp_loc, type, &type_loc);
+          MPI_Type_create_hindexed_block(n, elem_count[lo], disp_rem, type, &type_rem);
+        } else {
+          MPI_Type_create_hindexed(n, &elem_count[lo], disp_loc, type, &type_loc);
+          MPI_Type_create_hindexed(n, &elem_count[lo], disp_rem, type, &type_rem);
+        }
+
+        flush_local = ARMCII_Iov_op_typed(op, mreg, MPI_BOTTOM, type_loc, MPI_BOTTOM, type_rem, proc);
+      }
 
-    for (i = 0; i < count; i++) {
-      MPI_Aint target_rem;
-      MPI_Get_address(buf_loc[i], &disp_loc[i]);
-      MPI_Get_address(buf_rem[i], &target_rem);
-      disp_rem[i]  = (target_rem - base_rem)/type_size;
-      block_len[i] = elem_count;
-
-      ARMCII_Assert_msg((target_rem - base_rem) % type_size == 0, "Transfer size is not a multiple of type size");
-      ARMCII_Assert_msg(disp_rem[i] >= 0 && disp_rem[i] < dst_win_size, "Invalid remote pointer");
-      ARMCII_Assert_msg(((uint8_t*)buf_rem[i]) + block_len[i] <= ((uint8_t*)dst_win_base) + dst_win_size, "Transfer exceeds buffer length");
+      ARMCII_Scratch_put(disp_loc);
     }
 
-    MPI_Type_create_hindexed(count, block_len, disp_loc, type, &type_loc);
-    MPI_Type_create_indexed_block(count, elem_count, disp_rem, type, &type_rem);
+    if (blocking) {
+      gmr_flush(mreg, proc, flush_local);
+    }
 
-    /* MPI_Type_create_indexed_block should be more efficient than this:
-       MPI_Type_indexed(count, block_len, disp_rem, type, &type_rem); */
+    return 0;
+}
 
-    MPI_Type_commit(&type_loc);
-    MPI_Type_commit(&type_rem);
 
-    switch(op) {
-      case ARMCII_OP_PUT:
-        gmr_put_typed(mreg, MPI_BOTTOM, 1, type_loc, MPI_BOTTOM, 1, type_rem, proc);
-        flush_local = 1;
-        break;
-      case ARMCII_OP_GET:
-        gmr_get_typed(mreg, MPI_BOTTOM, 1, type_rem, MPI_BOTTOM, 1, type_loc, proc);
-        flush_local = 0;
-        break;
-      case ARMCII_OP_ACC:
-        gmr_accumulate_typed(mreg, MPI_BOTTOM, 1, type_loc, MPI_BOTTOM, 1, type_rem, proc);
-        flush_local = 1;
-        break;
-      default:
-        ARMCII_Error("unknown operation (%d)", op);
-        return 1;
+/** Perform one I/O vector entry: check the remote buffers, stage private
+  * copies of shared local buffers and issue the transfer.  Puts and gets that
+  * needed private copies are completed before returning, so that the copies
+  * can be released.  When an accumulate is not blocking, its private copies
+  * are released when the handle completes.
+  *
+  * @param[in] op          Operation to be performed (ARMCII_OP_PUT, ...)
+  * @param[in] src         Array of source pointers
+  * @param[in] dst         Array of destination pointers
+  * @param[in] count       Length of pointer arrays
+  * @param[in] bytes       Size of each transfer
+  * @param[in] datatype    Data type for accumulate op (ignored for all others)
+  * @param[in] scale       Scale for accumulate op (ignored for all others)
+  * @param[in] proc        Target process
+  * @param[in] blocking    Complete the transfer before returning
+  * @param[in] handle      Handle the transfer is tracked by (nonblocking only)
+  * @return                Zero on success, error code otherwise
+  */
+int ARMCII_Iov_op_vec(enum ARMCII_Op_e op, void **src, void **dst, int count, int bytes,
+    int datatype, void *scale, int proc, int blocking, armci_hdl_t *handle) {
+
+  void **buf;
+  int    overlapping, same_alloc, moved;
+
+  if (count == 0) return 0; // NOP //
+  if (bytes == 0) return 0; // NOP //
+
+  // For get, the local destination is checked for overlap
+  overlapping = ARMCII_Iov_check_overlap(dst, count, bytes);
+  same_alloc  = ARMCII_Iov_check_same_allocation_sizes(op == ARMCII_OP_GET ? src : dst, count, bytes, NULL, proc);
+
+  switch(op) {
+    case ARMCII_OP_PUT:
+      moved = ARMCII_Buf_prepare_read_vec(src, &buf, count, bytes);
+      ARMCII_Iov_op_dispatch(ARMCII_OP_PUT, buf, dst, count, bytes, 0,
+                             overlapping, same_alloc, proc, blocking || moved > 0);
+      ARMCII_Buf_finish_read_vec(src, buf, count, bytes);
+      break;
+
+    case ARMCII_OP_GET:
+      moved = ARMCII_Buf_prepare_write_vec(dst, &buf, count, bytes);
+      ARMCII_Iov_op_dispatch(ARMCII_OP_GET, src, buf, count, bytes, 0,
+                             overlapping, same_alloc, proc, blocking || moved > 0);
+      ARMCII_Buf_finish_write_vec(dst, buf, count, bytes);
+      break;
+
+    case ARMCII_OP_ACC:
+      ARMCII_Buf_prepare_acc_vec(src, &buf, count, bytes, datatype, scale);
+      ARMCII_Iov_op_dispatch(ARMCII_OP_ACC, buf, dst, count, bytes, datatype,
+                             overlapping, same_alloc, proc, blocking);
+
+      /* Scaled copies may still be in use by an operation that was not flushed */
+      if (blocking) {
+        ARMCII_Buf_finish_acc_vec(src, buf, count, bytes);
+      } else {
+        int i;
+
+        for (i = 0; i < count; i++)
+          if (buf[i] != src[i])
+            ARMCII_Hdl_defer(handle, proc, buf[i], NULL, NULL, NULL, 0);
+
+        ARMCII_Scratch_put(buf);
+      }
+      break;
+
+    default:
+      ARMCII_Error("unknown operation (%d)", op);
+      return 1;
+  }
+
+  return 0;
+}
+
+
+/** Perform an I/O vector operation whose blocks have individual sizes.
+  * Descriptors that target the same allocation are fused and issued together
+  * with the method selected by ARMCI_IOV_METHOD: DIRECT describes them with
+  * datatypes, BATCHED issues them as separate operations and AUTO chooses
+  * between the two.  Descriptors in different allocations are issued
+  * separately, even when the allocations share a slab or dynamic window.
+  * Each window is flushed once after the blocks of all descriptors have been
+  * issued.
+  *
+  * @param[in] op       Operation to be performed (ARMCII_OP_PUT, ...)
+  * @param[in] datatype Data type for accumulate op (ignored for all others)
+  * @param[in] scale    Scale for accumulate op (ignored for all others)
+  * @param[in] iov      Descriptors
+  * @param[in] iov_len  Number of descriptors
+  * @param[in] proc     Target process
+  * @return             Zero on success, error code otherwise
+  */
+static int ARMCII_Iov_op_irreg(enum ARMCII_Op_e op, int datatype, void *scale,
+    armcix_giov_irreg_t *iov, int iov_len, int proc) {
+
+  MPI_Datatype type = MPI_BYTE;
+  int          type_size = 1, scaled = 0;
+  int          total = 0, count, start, overlapping, same_alloc, consrv, ret = 0, v, w, i;
+  void       **rem, **loc, **tmp;
+  int         *bytes;
+  iov_seg_t   *segs;
+  gmr_t      **mregs;
+
+  if (op == ARMCII_OP_ACC) {
+    ARMCII_Acc_type_translate(datatype, &type, &type_size);
+    scaled = ARMCII_Buf_acc_is_scaled(datatype, scale);
+  }
+
+  for (v = 0; v < iov_len; v++)
+    total += iov[v].ptr_array_len;
+
+  if (total == 0) return 0; // NOP //
+
+  rem = ARMCII_Scratch_get((3*sizeof(void*) + sizeof(iov_seg_t) + sizeof(int))*total
+                           + sizeof(gmr_t*)*iov_len);
+  ARMCII_Assert(rem != NULL);
+
+  loc   = rem + total;
+  tmp   = loc + total;
+  mregs = (gmr_t**) (tmp + total);
+  segs  = (iov_seg_t*) (mregs + iov_len);
+  bytes = (int*) (segs + total);
+
+  // A descriptor lies within one allocation; find it
+
+  for (v = 0; v < iov_len; v++) {
+    mregs[v] = NULL;
+
+    for (i = 0; i < iov[v].ptr_array_len && mregs[v] == NULL; i++) {
+      if (iov[v].bytes_array[i] == 0) continue;
+
+      mregs[v] = gmr_lookup(op == ARMCII_OP_GET ? iov[v].src_ptr_array[i] : iov[v].dst_ptr_array[i], proc);
+      ARMCII_Assert_msg(mregs[v] != NULL, "Invalid remote pointer");
     }
+  }
 
-    if (blocking) {
-      gmr_flush(mreg, proc, flush_local);
+  for (v = 0, start = 0; v < iov_len; v++) {
+    if (mregs[v] == NULL) continue;
+
+    // Skip allocations already issued with an earlier descriptor
+    for (w = 0; w < v && mregs[w] != mregs[v]; w++) ;
+    if (w < v) continue;
+
+    // Gather the non-empty blocks of all descriptors on this allocation
+
+    for (w = v, count = 0; w < iov_len; w++) {
+      if (mregs[w] != mregs[v]) continue;
+
+      for (i = 0; i < iov[w].ptr_array_len; i++) {
+        const int k = start + count;
+
+        if (iov[w].bytes_array[i] == 0) continue;
+
+        ARMCII_Assert_msg(iov[w].bytes_array[i] > 0 && iov[w].bytes_array[i] % type_size == 0,
+                          "Transfer size is not a multiple of type size");
+
+        rem[k]   = (op == ARMCII_OP_GET) ? iov[w].src_ptr_array[i] : iov[w].dst_ptr_array[i];
+        loc[k]   = (op == ARMCII_OP_GET) ? iov[w].dst_ptr_array[i] : iov[w].src_ptr_array[i];
+        bytes[k] = iov[w].bytes_array[i];
+        count++;
+      }
     }
 
-    MPI_Type_free(&type_loc);
-    MPI_Type_free(&type_rem);
+    // For get, the local destination is checked for overlap
+    overlapping = ARMCII_Iov_check_overlap_sizes(op == ARMCII_OP_GET ? &loc[start] : &rem[start],
+                                                 count, 0, &bytes[start]);
+    same_alloc  = ARMCII_Iov_check_same_allocation_sizes(&rem[start], count, 0, &bytes[start], proc);
+    consrv      = overlapping || !same_alloc || ARMCII_GLOBAL_STATE.iov_method == ARMCII_IOV_CONSRV;
 
-    return 0;
+    if (overlapping) ARMCII_Warning("IOV remote buffers overlap\n");
+    if (!same_alloc) ARMCII_Warning("IOV remote buffers are not within the same allocation\n");
+
+    // Stage scaled copies and private copies of shared local buffers
+
+    for (i = start; i < start + count; i++) {
+      const int shared = ARMCII_GLOBAL_STATE.shr_buf_method != ARMCII_SHR_BUF_NOGUARD
+                         && gmr_lookup(loc[i], ARMCI_GROUP_WORLD.rank) != NULL;
+
+      tmp[i] = NULL;
+
+      if (scaled || shared) {
+        tmp[i] = ARMCII_Scratch_get(bytes[i]);
+        ARMCII_Assert(tmp[i] != NULL);
+
+        if (scaled)
+          ARMCII_Buf_acc_scale(loc[i], tmp[i], bytes[i], datatype, scale);
+        else if (op != ARMCII_OP_GET)
+          ARMCI_Copy(loc[i], tmp[i], bytes[i]);
+      }
+
+      segs[i].src = (op == ARMCII_OP_GET) ? rem[i] : (tmp[i] ? tmp[i] : loc[i]);
+      segs[i].dst = (op == ARMCII_OP_GET) ? (tmp[i] ? tmp[i] : loc[i]) : rem[i];
+      segs[i].len = bytes[i] / type_size;
+    }
+
+    ret |= ARMCII_Iov_op_segs(op, &segs[start], count, type, type_size, consrv, proc, 0 /* not blocking */);
+
+    start += count;
+  }
+
+  // Complete every window once; allocations in a slab or dynamic window
+  // share the window of their parent
+
+  for (v = 0; v < iov_len; v++)
+    if (mregs[v] != NULL && mregs[v]->parent != NULL)
+      mregs[v] = mregs[v]->parent;
+
+  for (v = 0; v < iov_len; v++) {
+    if (mregs[v] == NULL) continue;
+
+    for (w = 0; w < v && mregs[w] != mregs[v]; w++) ;
+    if (w < v) continue;
+
+    gmr_flush(mregs[v], proc, op != ARMCII_OP_GET);
+  }
+
+  for (i = 0; i < start; i++) {
+    if (tmp[i] == NULL) continue;
+
+    if (op == ARMCII_OP_GET)
+      ARMCI_Copy(tmp[i], loc[i], bytes[i]);
+
+    ARMCII_Scratch_put(tmp[i]);
+  }
+
+  ARMCII_Scratch_put(rem);
+
+  return ret;
+}
+
+
+/** Perform a vector operation with several descriptors.  The descriptors are
+  * fused so that each allocation is issued and each window flushed once.
+  */
+static int ARMCII_Iov_op_fused(enum ARMCII_Op_e op, int datatype, void *scale,
+    armci_giov_t *iov, int iov_len, int proc) {
+
+  armcix_giov_irreg_t *irreg;
+  int *bytes, total = 0, v, i, ret;
+
+  for (v = 0; v < iov_len; v++)
+    total += iov[v].ptr_array_len;
+
+  if (total == 0) return 0; // NOP //
+
+  irreg = ARMCII_Scratch_get(sizeof(armcix_giov_irreg_t)*iov_len + sizeof(int)*total);
+  ARMCII_Assert(irreg != NULL);
+  bytes = (int*) (irreg + iov_len);
+
+  for (v = 0, total = 0; v < iov_len; v++) {
+    irreg[v].src_ptr_array = iov[v].src_ptr_array;
+    irreg[v].dst_ptr_array = iov[v].dst_ptr_array;
+    irreg[v].ptr_array_len = iov[v].ptr_array_len;
+    irreg[v].bytes_array   = &bytes[total];
+
+    for (i = 0; i < iov[v].ptr_array_len; i++)
+      bytes[total++] = iov[v].bytes;
+  }
+
+  ret = ARMCII_Iov_op_irreg(op, datatype, scale, irreg, iov_len, proc);
+
+  ARMCII_Scratch_put(irreg);
+
+  return ret;
 }
 
 
@@ -401,21 +1036,13 @@ int ARMCII_Iov_op_datatype(enum ARMCII_Op_e op, void **src, void **dst, int coun
 int PARMCI_PutV(armci_giov_t *iov, int iov_len, int proc) {
   int v;
 
-  for (v = 0; v < iov_len; v++) {
-    void **src_buf;
-    int    overlapping, same_alloc;
-
-    if (iov[v].ptr_array_len == 0) continue; // NOP //
-    if (iov[v].bytes == 0) continue; // NOP //
-
-    overlapping = ARMCII_Iov_check_overlap(iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes);
-    same_alloc  = ARMCII_Iov_check_same_allocation(iov[v].dst_ptr_array, iov[v].ptr_array_len, proc);
+  /* Several descriptors are fused into one operation per window */
+  if (iov_len > 1)
+    return ARMCII_Iov_op_fused(ARMCII_OP_PUT, 0, NULL, iov, iov_len, proc);
 
-    ARMCII_Buf_prepare_read_vec(iov[v].src_ptr_array, &src_buf, iov[v].ptr_array_len, iov[v].bytes);
-    ARMCII_Iov_op_dispatch(ARMCII_OP_PUT, src_buf, iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes, 0,
-                           overlapping, same_alloc, proc, 1 /* blocking */);
-    ARMCII_Buf_finish_read_vec(iov[v].src_ptr_array, src_buf, iov[v].ptr_array_len, iov[v].bytes);
-  }
+  for (v = 0; v < iov_len; v++)
+    ARMCII_Iov_op_vec(ARMCII_OP_PUT, iov[v].src_ptr_array, iov[v].dst_ptr_array, iov[v].ptr_array_len,
+                      iov[v].bytes, 0, NULL, proc, 1 /* blocking */, NULL);
 
   return 0;
 }
@@ -441,22 +1068,13 @@ int PARMCI_PutV(armci_giov_t *iov, int iov_len, int proc) {
 int PARMCI_GetV(armci_giov_t *iov, int iov_len, int proc) {
   int v;
 
-  for (v = 0; v < iov_len; v++) {
-    void **dst_buf;
-    int    overlapping, same_alloc;
-
-    if (iov[v].ptr_array_len == 0) continue; // NOP //
-    if (iov[v].bytes == 0) continue; // NOP //
-
-    // overlapping = ARMCII_Iov_check_overlap(iov[v].src_ptr_array, iov[v].ptr_array_len, iov[v].bytes);
-    overlapping = ARMCII_Iov_check_overlap(iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes);
-    same_alloc  = ARMCII_Iov_check_same_allocation(iov[v].src_ptr_array, iov[v].ptr_array_len, proc);
+  /* Several descriptors are fused into one operation per window */
+  if (iov_len > 1)
+    return ARMCII_Iov_op_fused(ARMCII_OP_GET, 0, NULL, iov, iov_len, proc);
 
-    ARMCII_Buf_prepare_write_vec(iov[v].dst_ptr_array, &dst_buf, iov[v].ptr_array_len, iov[v].bytes);
-    ARMCII_Iov_op_dispatch(ARMCII_OP_GET, iov[v].src_ptr_array, dst_buf, iov[v].ptr_array_len, iov[v].bytes, 0,
-                           overlapping, same_alloc, proc, 1 /* blocking */);
-    ARMCII_Buf_finish_write_vec(iov[v].dst_ptr_array, dst_buf, iov[v].ptr_array_len, iov[v].bytes);
-  }
+  for (v = 0; v < iov_len; v++)
+    ARMCII_Iov_op_vec(ARMCII_OP_GET, iov[v].src_ptr_array, iov[v].dst_ptr_array, iov[v].ptr_array_len,
+                      iov[v].bytes, 0, NULL, proc, 1 /* blocking */, NULL);
 
   return 0;
 }
@@ -482,21 +1100,51 @@ int PARMCI_GetV(armci_giov_t *iov, int iov_len, int proc) {
 int PARMCI_AccV(int datatype, void *scale, armci_giov_t *iov, int iov_len, int proc) {
   int v;
 
-  for (v = 0; v < iov_len; v++) {
-    void **src_buf;
-    int    overlapping, same_alloc;
+  /* Several descriptors are fused into one operation per window */
+  if (iov_len > 1)
+    return ARMCII_Iov_op_fused(ARMCII_OP_ACC, datatype, scale, iov, iov_len, proc);
 
-    if (iov[v].ptr_array_len == 0) continue; // NOP //
-    if (iov[v].bytes == 0) continue; // NOP //
+  for (v = 0; v < iov_len; v++)
+    ARMCII_Iov_op_vec(ARMCII_OP_ACC, iov[v].src_ptr_array, iov[v].dst_ptr_array, iov[v].ptr_array_len,
+                      iov[v].bytes, datatype, scale, proc, 1 /* blocking */, NULL);
 
-    overlapping = ARMCII_Iov_check_overlap(iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes);
-    same_alloc  = ARMCII_Iov_check_same_allocation(iov[v].dst_ptr_array, iov[v].ptr_array_len, proc);
+  return 0;
+}
 
-    ARMCII_Buf_prepare_acc_vec(iov[v].src_ptr_array, &src_buf, iov[v].ptr_array_len, iov[v].bytes, datatype, scale);
-    ARMCII_Iov_op_dispatch(ARMCII_OP_ACC, src_buf, iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes, datatype,
-                           overlapping, same_alloc, proc, 1 /* blocking */);
-    ARMCII_Buf_finish_acc_vec(iov[v].src_ptr_array, src_buf, iov[v].ptr_array_len, iov[v].bytes);
-  }
 
-  return 0;
+/** I/O vector one-sided put with a size for each block.
+  *
+  * @param[in] iov      Vector of transfer information.
+  * @param[in] iov_len  Length of iov.
+  * @param[in] proc     Target process.
+  * @return             Success 0, otherwise non-zero.
+  */
+int ARMCIX_PutV_irreg(armcix_giov_irreg_t *iov, int iov_len, int proc) {
+  return ARMCII_Iov_op_irreg(ARMCII_OP_PUT, 0, NULL, iov, iov_len, proc);
+}
+
+
+/** I/O vector one-sided get with a size for each block.
+  *
+  * @param[in] iov      Vector of transfer information.
+  * @param[in] iov_len  Length of iov.
+  * @param[in] proc     Target process.
+  * @return             Success 0, otherwise non-zero.
+  */
+int ARMCIX_GetV_irreg(armcix_giov_irreg_t *iov, int iov_len, int proc) {
+  return ARMCII_Iov_op_irreg(ARMCII_OP_GET, 0, NULL, iov, iov_len, proc);
+}
+
+
+/** I/O vector one-sided accumulate with a size for each block.
+  *
+  * @param[in] datatype ARMCI data type for the accumulate operation (see armci.h)
+  * @param[in] scale    Scale factor of type datatype
+  * @param[in] iov      Vector of transfer information.
+  * @param[in] iov_len  Length of iov.
+  * @param[in] proc     Target process.
+  * @return             Success 0, otherwise non-zero.
+  */
+int ARMCIX_AccV_irreg(int datatype, void *scale, armcix_giov_irreg_t *iov, int iov_len, int proc) {
+  return ARMCII_Iov_op_irreg(ARMCII_OP_ACC, datatype, scale, iov, iov_len, proc);
 }
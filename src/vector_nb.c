@@ -35,26 +35,13 @@ int PARMCI_NbPutV(armci_giov_t *iov, int iov_len, int proc, armci_hdl_t* handle)
       blocking = 1;
   }
 
-  for (v = 0; v < iov_len; v++) {
-    void **src_buf;
-    int    overlapping, same_alloc;
+  ARMCII_Hdl_begin(handle);
 
-    if (iov[v].ptr_array_len == 0) continue; // NOP //
-    if (iov[v].bytes == 0) continue; // NOP //
+  for (v = 0; v < iov_len; v++)
+    ARMCII_Iov_op_vec(ARMCII_OP_PUT, iov[v].src_ptr_array, iov[v].dst_ptr_array, iov[v].ptr_array_len,
+                      iov[v].bytes, 0, NULL, proc, blocking, handle);
 
-    overlapping = ARMCII_Iov_check_overlap(iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes);
-    same_alloc  = ARMCII_Iov_check_same_allocation(iov[v].dst_ptr_array, iov[v].ptr_array_len, proc);
-
-    ARMCII_Buf_prepare_read_vec(iov[v].src_ptr_array, &src_buf, iov[v].ptr_array_len, iov[v].bytes);
-    ARMCII_Iov_op_dispatch(ARMCII_OP_PUT, src_buf, iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes, 0,
-                           overlapping, same_alloc, proc, blocking);
-    ARMCII_Buf_finish_read_vec(iov[v].src_ptr_array, src_buf, iov[v].ptr_array_len, iov[v].bytes);
-  }
-
-  if (handle!=NULL) {
-      /* Regular (not aggregate) handles merely store the target for future flushing. */
-      handle->target = proc;
-  }
+  ARMCII_Hdl_end(handle, proc);
 
   gmr_progress();
 
@@ -87,27 +74,13 @@ int PARMCI_NbGetV(armci_giov_t *iov, int iov_len, int proc, armci_hdl_t* handle)
       blocking = 1;
   }
 
-  for (v = 0; v < iov_len; v++) {
-    void **dst_buf;
-    int    overlapping, same_alloc;
-
-    if (iov[v].ptr_array_len == 0) continue; // NOP //
-    if (iov[v].bytes == 0) continue; // NOP //
-
-    // overlapping = ARMCII_Iov_check_overlap(iov[v].src_ptr_array, iov[v].ptr_array_len, iov[v].bytes);
-    overlapping = ARMCII_Iov_check_overlap(iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes);
-    same_alloc  = ARMCII_Iov_check_same_allocation(iov[v].src_ptr_array, iov[v].ptr_array_len, proc);
+  ARMCII_Hdl_begin(handle);
 
-    ARMCII_Buf_prepare_write_vec(iov[v].dst_ptr_array, &dst_buf, iov[v].ptr_array_len, iov[v].bytes);
-    ARMCII_Iov_op_dispatch(ARMCII_OP_GET, iov[v].src_ptr_array, dst_buf, iov[v].ptr_array_len, iov[v].bytes, 0,
-                           overlapping, same_alloc, proc, blocking);
-    ARMCII_Buf_finish_write_vec(iov[v].dst_ptr_array, dst_buf, iov[v].ptr_array_len, iov[v].bytes);
-  }
+  for (v = 0; v < iov_len; v++)
+    ARMCII_Iov_op_vec(ARMCII_OP_GET, iov[v].src_ptr_array, iov[v].dst_ptr_array, iov[v].ptr_array_len,
+                      iov[v].bytes, 0, NULL, proc, blocking, handle);
 
-  if (handle!=NULL) {
-      /* Regular (not aggregate) handles merely store the target for future flushing. */
-      handle->target = proc;
-  }
+  ARMCII_Hdl_end(handle, proc);
 
   gmr_progress();
 
@@ -140,26 +113,13 @@ int PARMCI_NbAccV(int datatype, void *scale, armci_giov_t *iov, int iov_len, int
       blocking = 1;
   }
 
-  for (v = 0; v < iov_len; v++) {
-    void **src_buf;
-    int    overlapping, same_alloc;
-
-    if (iov[v].ptr_array_len == 0) continue; // NOP //
-    if (iov[v].bytes == 0) continue; // NOP //
+  ARMCII_Hdl_begin(handle);
 
-    overlapping = ARMCII_Iov_check_overlap(iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes);
-    same_alloc  = ARMCII_Iov_check_same_allocation(iov[v].dst_ptr_array, iov[v].ptr_array_len, proc);
+  for (v = 0; v < iov_len; v++)
+    ARMCII_Iov_op_vec(ARMCII_OP_ACC, iov[v].src_ptr_array, iov[v].dst_ptr_array, iov[v].ptr_array_len,
+                      iov[v].bytes, datatype, scale, proc, blocking, handle);
 
-    ARMCII_Buf_prepare_acc_vec(iov[v].src_ptr_array, &src_buf, iov[v].ptr_array_len, iov[v].bytes, datatype, scale);
-    ARMCII_Iov_op_dispatch(ARMCII_OP_ACC, src_buf, iov[v].dst_ptr_array, iov[v].ptr_array_len, iov[v].bytes, datatype,
-                           overlapping, same_alloc, proc, blocking);
-    ARMCII_Buf_finish_acc_vec(iov[v].src_ptr_array, src_buf, iov[v].ptr_array_len, iov[v].bytes);
-  }
-
-  if (handle!=NULL) {
-      /* Regular (not aggregate) handles merely store the target for future flushing. */
-      handle->target = proc;
-  }
+  ARMCII_Hdl_end(handle, proc);
 
   gmr_progress();
 
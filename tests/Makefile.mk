@@ -10,6 +10,7 @@ check_PROGRAMS += tests/test_onesided         \
                   tests/test_mutex_trylock    \
                   tests/test_malloc           \
                   tests/test_malloc_irreg     \
+                  tests/test_malloc_slab      \
                   tests/ARMCI_PutS_latency    \
                   tests/ARMCI_AccS_latency    \
                   tests/test_groups           \
@@ -17,10 +18,19 @@ check_PROGRAMS += tests/test_onesided         \
                   tests/test_malloc_group     \
                   tests/test_accs             \
                   tests/test_accs_dla         \
+                  tests/test_acc_types        \
                   tests/test_puts             \
                   tests/test_puts_gets        \
                   tests/test_puts_gets_dla    \
+                  tests/test_strided_normalize \
                   tests/test_putv             \
+                  tests/test_iov_coalesce     \
+                  tests/test_iov_irreg        \
+                  tests/test_iov_multi        \
+                  tests/test_atomicity        \
+                  tests/test_large            \
+                  tests/test_iov_checks       \
+                  tests/test_nb_handles       \
                   tests/test_assert           \
                   tests/test_igop             \
                   tests/test_rmw_fadd         \
@@ -35,6 +45,7 @@ TESTS          += tests/test_onesided         \
                   tests/test_mutex_trylock    \
                   tests/test_malloc           \
                   tests/test_malloc_irreg     \
+                  tests/test_malloc_slab      \
                   tests/ARMCI_PutS_latency    \
                   tests/ARMCI_AccS_latency    \
                   tests/test_groups           \
@@ -42,10 +53,19 @@ TESTS          += tests/test_onesided         \
                   tests/test_malloc_group     \
                   tests/test_accs             \
                   tests/test_accs_dla         \
+                  tests/test_acc_types        \
                   tests/test_puts             \
                   tests/test_puts_gets        \
                   tests/test_puts_gets_dla    \
+                  tests/test_strided_normalize \
                   tests/test_putv             \
+                  tests/test_iov_coalesce     \
+                  tests/test_iov_irreg        \
+                  tests/test_iov_multi        \
+                  tests/test_atomicity        \
+                  tests/test_large            \
+                  tests/test_iov_checks       \
+                  tests/test_nb_handles       \
                   tests/test_igop             \
                   tests/test_rmw_fadd         \
                   tests/test_parmci           \
@@ -62,6 +82,7 @@ tests_test_mutex_rmw_LDADD = libarmci.la
 tests_test_mutex_trylock_LDADD = libarmci.la
 tests_test_malloc_LDADD = libarmci.la
 tests_test_malloc_irreg_LDADD = libarmci.la
+tests_test_malloc_slab_LDADD = libarmci.la
 tests_ARMCI_PutS_latency_LDADD = libarmci.la
 tests_ARMCI_AccS_latency_LDADD = libarmci.la
 tests_test_groups_LDADD = libarmci.la
@@ -69,10 +90,19 @@ tests_test_group_split_LDADD = libarmci.la
 tests_test_malloc_group_LDADD = libarmci.la
 tests_test_accs_LDADD = libarmci.la
 tests_test_accs_dla_LDADD = libarmci.la
+tests_test_acc_types_LDADD = libarmci.la
 tests_test_puts_LDADD = libarmci.la
 tests_test_puts_gets_LDADD = libarmci.la
 tests_test_puts_gets_dla_LDADD = libarmci.la
+tests_test_strided_normalize_LDADD = libarmci.la
 tests_test_putv_LDADD = libarmci.la
+tests_test_iov_coalesce_LDADD = libarmci.la
+tests_test_iov_irreg_LDADD = libarmci.la
+tests_test_iov_multi_LDADD = libarmci.la
+tests_test_atomicity_LDADD = libarmci.la
+tests_test_large_LDADD = libarmci.la
+tests_test_iov_checks_LDADD = libarmci.la
+tests_test_nb_handles_LDADD = libarmci.la
 tests_test_assert_LDADD = libarmci.la
 tests_test_igop_LDADD = libarmci.la
 tests_test_rmw_fadd_LDADD = libarmci.la
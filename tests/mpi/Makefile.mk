@@ -3,6 +3,7 @@
 #
 
 check_PROGRAMS += \
+                  tests/mpi/pack_bench                  \
                   tests/mpi/ping-pong-mpi               \
                   tests/mpi/test_mpi_accs               \
                   tests/mpi/test_mpi_dim                \
@@ -15,6 +16,7 @@ check_PROGRAMS += \
                   # end
 
 TESTS          += \
+                  tests/mpi/pack_bench                  \
                   tests/mpi/test_mpi_accs               \
                   tests/mpi/test_mpi_dim                \
                   tests/mpi/test_mpi_indexed_accs       \
@@ -26,6 +28,7 @@ TESTS          += \
                   #tests/mpi/ping-pong-mpi      \
                   # end
 
+tests_mpi_pack_bench_LDADD = libarmci.la
 tests_mpi_ping_pong_mpi_LDADD = libarmci.la
 tests_mpi_test_mpi_accs_LDADD = libarmci.la
 tests_mpi_test_mpi_indexed_accs_LDADD = libarmci.la
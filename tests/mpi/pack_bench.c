@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** Strided pack/unpack benchmark
+  *
+  * Compares armci_write_strided/armci_read_strided against MPI_Pack/
+  * MPI_Unpack of an equivalent hvector datatype for a range of patch shapes,
+  * and checks that both produce the same packed data.  Each process runs the
+  * benchmark on its own; rank 0 reports.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#include <mpi.h>
+#include <armci.h>
+
+#define MAX_DATA_SIZE  (16*1024*1024)
+#define NUM_ITERATIONS  8
+#define NUM_WARMUP_ITER 1
+
+typedef struct {
+  int levels;
+  int count[3];  /* count[0] in bytes */
+  int stride[2]; /* Bytes             */
+} shape_t;
+
+static const shape_t shapes[] = {
+  { 1, {    8, 4096,   0 }, {    64,      0 } },
+  { 1, {   16, 4096,   0 }, {    64,      0 } },
+  { 1, {   32, 4096,   0 }, {   128,      0 } },
+  { 1, {   64, 4096,   0 }, {   256,      0 } },
+  { 1, {  200, 4096,   0 }, {   512,      0 } },
+  { 1, { 1024, 1024,   0 }, {  2048,      0 } },
+  { 2, {   64,   64,  64 }, {   128,  16384 } },
+  { 2, {  512,   64,  64 }, {  1024,  65536 } },
+  { 1, { 4096, 2048,   0 }, {  8192,      0 } },
+};
+
+#define NUM_SHAPES ((int) (sizeof(shapes)/sizeof(shapes[0])))
+
+/* Build the MPI datatype equivalent to a strided patch */
+static MPI_Datatype shape_type(const shape_t *s) {
+  MPI_Datatype type, tmp;
+  int i;
+
+  MPI_Type_contiguous(s->count[0], MPI_BYTE, &type);
+
+  for (i = 0; i < s->levels; i++) {
+    MPI_Type_create_hvector(s->count[i+1], 1, s->stride[i], type, &tmp);
+    MPI_Type_free(&type);
+    type = tmp;
+  }
+
+  MPI_Type_commit(&type);
+  return type;
+}
+
+int main(int argc, char **argv) {
+  int      rank, i, iter, errors = 0, total_errors;
+  uint8_t *src, *packed, *mpi_packed, *dst;
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+  src        = malloc(MAX_DATA_SIZE);
+  dst        = malloc(MAX_DATA_SIZE);
+  packed     = malloc(MAX_DATA_SIZE);
+  mpi_packed = malloc(MAX_DATA_SIZE);
+
+  for (i = 0; i < MAX_DATA_SIZE; i++)
+    src[i] = (uint8_t) (i*7 + 3);
+
+  if (rank == 0)
+    printf("%6s %6s %6s %6s %10s %12s %12s %12s %12s\n", "Levels", "Block", "Count1", "Count2",
+           "Bytes", "Pack (MiB/s)", "MPI (MiB/s)", "Unpk (MiB/s)", "MPI (MiB/s)");
+
+  for (i = 0; i < NUM_SHAPES; i++) {
+    const shape_t *s = &shapes[i];
+    MPI_Datatype   type = shape_type(s);
+    int            bytes, pos;
+    double         t_pack = 0, t_mpi_pack = 0, t_unpack = 0, t_mpi_unpack = 0, t;
+
+    bytes = s->count[0] * s->count[1] * (s->levels > 1 ? s->count[2] : 1);
+
+    for (iter = 0; iter < NUM_WARMUP_ITER + NUM_ITERATIONS; iter++) {
+      if (iter == NUM_WARMUP_ITER)
+        t_pack = t_mpi_pack = t_unpack = t_mpi_unpack = 0;
+
+      t = MPI_Wtime();
+      armci_write_strided(src, s->levels, (int*) s->stride, (int*) s->count, (char*) packed);
+      t_pack += MPI_Wtime() - t;
+
+      t = MPI_Wtime();
+      pos = 0;
+      MPI_Pack(src, 1, type, mpi_packed, bytes, &pos, MPI_COMM_SELF);
+      t_mpi_pack += MPI_Wtime() - t;
+
+      t = MPI_Wtime();
+      armci_read_strided(dst, s->levels, (int*) s->stride, (int*) s->count, (char*) packed);
+      t_unpack += MPI_Wtime() - t;
+
+      t = MPI_Wtime();
+      pos = 0;
+      MPI_Unpack(mpi_packed, bytes, &pos, dst, 1, type, MPI_COMM_SELF);
+      t_mpi_unpack += MPI_Wtime() - t;
+    }
+
+    if (memcmp(packed, mpi_packed, bytes) != 0) {
+      printf("%d: Packed data differs from MPI_Pack for shape %d\n", rank, i);
+      errors++;
+    }
+
+    /* Unpack into a cleared buffer and pack again to check the round trip */
+    memset(dst, 0, MAX_DATA_SIZE);
+    armci_read_strided(dst, s->levels, (int*) s->stride, (int*) s->count, (char*) packed);
+    pos = 0;
+    MPI_Pack(dst, 1, type, mpi_packed, bytes, &pos, MPI_COMM_SELF);
+
+    if (memcmp(packed, mpi_packed, bytes) != 0) {
+      printf("%d: Unpacked data differs for shape %d\n", rank, i);
+      errors++;
+    }
+
+    if (rank == 0)
+      printf("%6d %6d %6d %6d %10d %12.2f %12.2f %12.2f %12.2f\n", s->levels, s->count[0],
+             s->count[1], s->levels > 1 ? s->count[2] : 0, bytes,
+             NUM_ITERATIONS*bytes/t_pack/(1024*1024), NUM_ITERATIONS*bytes/t_mpi_pack/(1024*1024),
+             NUM_ITERATIONS*bytes/t_unpack/(1024*1024), NUM_ITERATIONS*bytes/t_mpi_unpack/(1024*1024));
+
+    MPI_Type_free(&type);
+  }
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  free(src);
+  free(dst);
+  free(packed);
+  free(mpi_packed);
+
+  if (rank == 0) {
+    if (total_errors == 0) printf("Test complete: PASS.\n");
+    else                   printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}
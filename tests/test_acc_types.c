@@ -0,0 +1,135 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI scaled accumulate test
+  *
+  * Accumulate a scaled, strided patch and a scaled contiguous buffer of every
+  * ARMCI accumulate type into the right neighbor.  Row lengths are not a
+  * multiple of any vector width so that both the vector and the tail parts of
+  * the scaling kernels are checked.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+
+#include <mpi.h>
+#include <armci.h>
+
+#define NROWS  5
+#define NCOLS  37   /* Elements accumulated per row */
+#define LDA    64   /* Elements between rows        */
+#define NTYPES 6
+
+static const int type_sizes[NTYPES] = {
+  sizeof(int), sizeof(long), sizeof(float), sizeof(double), 2*sizeof(float), 2*sizeof(double)
+};
+
+static const char *type_names[NTYPES] = { "INT", "LNG", "FLT", "DBL", "CPL", "DCP" };
+
+/* Set element i to v, or to v - vi for complex types */
+static void set_elem(int type, void *buf, int i, int v) {
+  switch (type) {
+    case ARMCI_ACC_INT: ((int*)buf)[i]    = v; break;
+    case ARMCI_ACC_LNG: ((long*)buf)[i]   = v; break;
+    case ARMCI_ACC_FLT: ((float*)buf)[i]  = v; break;
+    case ARMCI_ACC_DBL: ((double*)buf)[i] = v; break;
+    case ARMCI_ACC_CPL: ((float*)buf)[2*i]  = v; ((float*)buf)[2*i+1]  = -v; break;
+    case ARMCI_ACC_DCP: ((double*)buf)[2*i] = v; ((double*)buf)[2*i+1] = -v; break;
+  }
+}
+
+/* Scaling by 3, or by 2 + i for complex types, maps v - vi to 3v - vi */
+static int check_elem(int type, void *buf, int i, int v) {
+  switch (type) {
+    case ARMCI_ACC_INT: return ((int*)buf)[i]    == 3*v;
+    case ARMCI_ACC_LNG: return ((long*)buf)[i]   == 3*v;
+    case ARMCI_ACC_FLT: return ((float*)buf)[i]  == 3*v;
+    case ARMCI_ACC_DBL: return ((double*)buf)[i] == 3*v;
+    case ARMCI_ACC_CPL: return ((float*)buf)[2*i]  == 3*v && ((float*)buf)[2*i+1]  == -v;
+    case ARMCI_ACC_DCP: return ((double*)buf)[2*i] == 3*v && ((double*)buf)[2*i+1] == -v;
+  }
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  int     rank, nproc, right, left, type, i, j, errors = 0, total_errors;
+  void  **base_ptrs;
+  void   *src_buf;
+  int     scale_i = 3;
+  long    scale_l = 3;
+  float   scale_f = 3.0f, scale_c[2] = { 2.0f, 1.0f };
+  double  scale_d = 3.0,  scale_z[2] = { 2.0, 1.0 };
+  void   *scales[NTYPES] = { &scale_i, &scale_l, &scale_f, &scale_d, scale_c, scale_z };
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  right = (rank+1) % nproc;
+  left  = (rank+nproc-1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI scaled accumulate test with %d processes\n", nproc);
+
+  /* Strided patch followed by a contiguous row, for the largest type */
+  base_ptrs = malloc(sizeof(void*)*nproc);
+  ARMCI_Malloc(base_ptrs, (NROWS+1)*LDA*2*sizeof(double));
+  src_buf = malloc((NROWS+1)*LDA*2*sizeof(double));
+
+  for (type = 0; type < NTYPES; type++) {
+    const int size = type_sizes[type];
+    int       stride = LDA*size, count[2];
+    uint8_t  *local = base_ptrs[rank];
+
+    ARMCI_Access_begin(local);
+    for (i = 0; i < (NROWS+1)*LDA*2*(int)sizeof(double); i++)
+      local[i] = 0;
+    ARMCI_Access_end(local);
+
+    for (i = 0; i < (NROWS+1)*LDA; i++)
+      set_elem(type, src_buf, i, rank*1000 + i);
+
+    ARMCI_Barrier();
+
+    count[0] = NCOLS*size;
+    count[1] = NROWS;
+
+    ARMCI_AccS(type, scales[type], src_buf, &stride, base_ptrs[right], &stride, count, 1, right);
+    ARMCI_Acc(type, scales[type], ((uint8_t*)src_buf) + NROWS*stride,
+              ((uint8_t*)base_ptrs[right]) + NROWS*stride, NCOLS*size, right);
+
+    ARMCI_Barrier();
+
+    ARMCI_Access_begin(local);
+    for (i = 0; i <= NROWS; i++) {
+      for (j = 0; j < NCOLS; j++) {
+        if (!check_elem(type, local, i*LDA + j, left*1000 + i*LDA + j)) {
+          printf("%d: Error in %s accumulate at [%d, %d]\n", rank, type_names[type], i, j);
+          errors++;
+          break;
+        }
+      }
+    }
+    ARMCI_Access_end(local);
+  }
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  ARMCI_Free(base_ptrs[rank]);
+  free(base_ptrs);
+  free(src_buf);
+
+  if (total_errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    if (rank == 0) printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}
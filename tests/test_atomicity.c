@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI put/get atomicity policy test
+  *
+  * Give three allocations the ON, OFF and AUTO atomicity policies.  Put,
+  * accumulate and get back a block of each in the right neighbor, without
+  * synchronizing in between on the ON and AUTO allocations, whose puts and
+  * gets must stay ordered with respect to the accumulate.  Then check that
+  * AUTO is decided for the whole allocation at a barrier: plain while no
+  * process has accumulated into it, atomic everywhere once one process has.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+#include <armci.h>
+#include <armcix.h>
+#include <gmr.h>
+
+#define NELT 1024
+
+static const int   policy[3]      = { ARMCIX_ATOMICITY_ON, ARMCIX_ATOMICITY_OFF, ARMCIX_ATOMICITY_AUTO };
+static const char *policy_name[3] = { "ON", "OFF", "AUTO" };
+
+int main(int argc, char **argv) {
+  int     rank, nproc, right, a, i, errors = 0, total_errors;
+  void  **base_ptrs[3], **auto_ptrs;
+  gmr_t  *auto_mreg;
+  double  buf[NELT], one = 1.0;
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  right = (rank+1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI atomicity policy test with %d processes\n", nproc);
+
+  for (a = 0; a < 3; a++) {
+    base_ptrs[a] = malloc(sizeof(void*)*nproc);
+    ARMCI_Malloc(base_ptrs[a], NELT*sizeof(double));
+    ARMCIX_Set_atomicity(base_ptrs[a][rank], policy[a]);
+
+    if (ARMCIX_Get_atomicity(base_ptrs[a][rank]) != policy[a]) {
+      printf("%d: allocation %d has the wrong policy\n", rank, a);
+      errors++;
+    }
+  }
+
+  ARMCI_Barrier();
+
+  for (a = 0; a < 3; a++) {
+    for (i = 0; i < NELT; i++)
+      buf[i] = rank*NELT + i;
+
+    ARMCI_Put(buf, base_ptrs[a][right], NELT*sizeof(double), right);
+
+    /* Plain puts are not ordered with accumulates */
+    if (policy[a] == ARMCIX_ATOMICITY_OFF)
+      ARMCI_Fence(right);
+
+    ARMCI_Acc(ARMCI_ACC_DBL, &one, buf, base_ptrs[a][right], NELT*sizeof(double), right);
+
+    if (policy[a] == ARMCIX_ATOMICITY_OFF)
+      ARMCI_Fence(right);
+
+    for (i = 0; i < NELT; i++)
+      buf[i] = -1.0;
+
+    ARMCI_Get(base_ptrs[a][right], buf, NELT*sizeof(double), right);
+
+    for (i = 0; i < NELT; i++) {
+      if (buf[i] != 2.0*(rank*NELT + i)) {
+        printf("%d: %s error at %d: %f, expected %f\n", rank, policy_name[a], i, buf[i],
+               2.0*(rank*NELT + i));
+        errors++;
+        break;
+      }
+    }
+  }
+
+  /* AUTO keeps its policy after switching to atomic operations */
+  if (ARMCIX_Get_atomicity(base_ptrs[2][rank]) != ARMCIX_ATOMICITY_AUTO) {
+    printf("%d: AUTO policy was not kept\n", rank);
+    errors++;
+  }
+
+  /* AUTO is atomic until a barrier finds no accumulates */
+  auto_ptrs = malloc(sizeof(void*)*nproc);
+  ARMCI_Malloc(auto_ptrs, NELT*sizeof(double));
+  ARMCIX_Set_atomicity(auto_ptrs[rank], ARMCIX_ATOMICITY_AUTO);
+  auto_mreg = gmr_lookup(auto_ptrs[rank], rank);
+
+  if (!auto_mreg->rma_atomic) {
+    printf("%d: new AUTO allocation is not atomic\n", rank);
+    errors++;
+  }
+
+  ARMCI_Barrier();
+
+  if (auto_mreg->rma_atomic) {
+    printf("%d: AUTO allocation without accumulates is still atomic\n", rank);
+    errors++;
+  }
+
+  /* An accumulate from one process makes it atomic on every process */
+  if (rank == 0)
+    ARMCI_Acc(ARMCI_ACC_DBL, &one, buf, auto_ptrs[right], NELT*sizeof(double), right);
+
+  ARMCI_Barrier();
+
+  if (!auto_mreg->rma_atomic) {
+    printf("%d: AUTO allocation is not atomic after an accumulate\n", rank);
+    errors++;
+  }
+
+  ARMCI_Barrier();
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  for (a = 0; a < 3; a++) {
+    ARMCI_Free(base_ptrs[a][rank]);
+    free(base_ptrs[a]);
+  }
+
+  ARMCI_Free(auto_ptrs[rank]);
+  free(auto_ptrs);
+
+  if (total_errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    if (rank == 0) printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}
@@ -0,0 +1,179 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI I/O vector safety check test
+  *
+  * Usage: test_iov_checks [-t [nblk [reps]]]
+  *
+  * Check that the overlap check used by I/O vector operations accepts
+  * disjoint and touching blocks in any order and finds overlapping ones, and
+  * that the same allocation check rejects blocks that leave the allocation.
+  * With -t, also report the average cost per block of each check.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <mpi.h>
+#include <armci.h>
+#include <armci_internals.h>
+
+#define NBLK  1000
+#define BLK   64    /* Bytes per block */
+
+static void shuffle(void **ptrs, int n) {
+  int i;
+
+  for (i = 0; i < n; i++) {
+    int   j   = rand() % n;
+    void *tmp = ptrs[i];
+    ptrs[i] = ptrs[j];
+    ptrs[j] = tmp;
+  }
+}
+
+static double time_overlap(void **ptrs, int nblk, int reps) {
+  double t = MPI_Wtime();
+  int    r;
+
+  for (r = 0; r < reps; r++)
+    ARMCII_Iov_check_overlap(ptrs, nblk, BLK);
+
+  return (MPI_Wtime() - t)/((double) reps*nblk);
+}
+
+int main(int argc, char **argv) {
+  int      rank, nproc, right, i, nblk = NBLK, reps = 0, errors = 0, total_errors;
+  void   **base_ptrs, **ptrs, *pair[2];
+  uint8_t *priv;
+
+  setenv("ARMCI_IOV_CHECKS", "1", 1);
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  if (argc > 1 && strcmp(argv[1], "-t") == 0) {
+    nblk = (argc > 2) ? atoi(argv[2]) : 1000000;
+    reps = (argc > 3) ? atoi(argv[3]) : 5;
+  }
+
+  right = (rank+1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI I/O vector safety check test with %d processes\n", nproc);
+
+  base_ptrs = malloc(sizeof(void*)*nproc);
+  ARMCI_Malloc(base_ptrs, (armci_size_t) nblk*BLK);
+  ptrs = malloc(sizeof(void*)*nblk);
+  priv = malloc(BLK);
+
+  srand(rank+1);
+
+  /* Touching blocks, in order and shuffled */
+  for (i = 0; i < nblk; i++)
+    ptrs[i] = ((uint8_t*)base_ptrs[right]) + i*BLK;
+
+  if (ARMCII_Iov_check_overlap(ptrs, nblk, BLK)) {
+    printf("%d: sorted blocks reported as overlapping\n", rank);
+    errors++;
+  }
+
+  if (!ARMCII_Iov_check_same_allocation(ptrs, nblk, right)) {
+    printf("%d: blocks reported in different allocations\n", rank);
+    errors++;
+  }
+
+  shuffle(ptrs, nblk);
+
+  if (ARMCII_Iov_check_overlap(ptrs, nblk, BLK)) {
+    printf("%d: shuffled blocks reported as overlapping\n", rank);
+    errors++;
+  }
+
+  if (!ARMCII_Iov_check_same_allocation(ptrs, nblk, right)) {
+    printf("%d: shuffled blocks reported in different allocations\n", rank);
+    errors++;
+  }
+
+  /* Shift one block onto its neighbor */
+  for (i = 0; i < nblk; i++)
+    if (ptrs[i] == ((uint8_t*)base_ptrs[right]) + (nblk/2)*BLK)
+      ptrs[i] = ((uint8_t*)ptrs[i]) - 1;
+
+  if (!ARMCII_Iov_check_overlap(ptrs, nblk, BLK)) {
+    printf("%d: overlapping blocks not found\n", rank);
+    errors++;
+  }
+
+  /* Mix in a private buffer */
+  ptrs[nblk/2] = priv;
+
+  if (ARMCII_Iov_check_same_allocation(ptrs, nblk, right)) {
+    printf("%d: private block reported in the allocation\n", rank);
+    errors++;
+  }
+
+  /* A private block below the allocation, in either position */
+  pair[0] = base_ptrs[right];
+  pair[1] = ((uint8_t*)base_ptrs[right]) - BLK;
+
+  if (ARMCII_Iov_check_same_allocation(pair, 2, right)) {
+    printf("%d: lower private block after a shared one reported in the allocation\n", rank);
+    errors++;
+  }
+
+  pair[0] = pair[1];
+  pair[1] = base_ptrs[right];
+
+  if (ARMCII_Iov_check_same_allocation(pair, 2, right)) {
+    printf("%d: lower private block before a shared one reported in the allocation\n", rank);
+    errors++;
+  }
+
+  if (reps > 0) {
+    double t_sorted, t_shuffled, t_alloc, t;
+    int    r;
+
+    for (i = 0; i < nblk; i++)
+      ptrs[i] = ((uint8_t*)base_ptrs[right]) + i*BLK;
+
+    t_sorted = time_overlap(ptrs, nblk, reps);
+
+    t = MPI_Wtime();
+    for (r = 0; r < reps; r++)
+      ARMCII_Iov_check_same_allocation(ptrs, nblk, right);
+    t_alloc = (MPI_Wtime() - t)/((double) reps*nblk);
+
+    shuffle(ptrs, nblk);
+    t_shuffled = time_overlap(ptrs, nblk, reps);
+
+    if (rank == 0)
+      printf("%d blocks, %d reps: overlap %.2f ns/block sorted, %.2f ns/block shuffled; "
+             "same allocation %.2f ns/block\n", nblk, reps, 1.0e9*t_sorted, 1.0e9*t_shuffled,
+             1.0e9*t_alloc);
+  }
+
+  ARMCI_Barrier();
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  ARMCI_Free(base_ptrs[rank]);
+  free(base_ptrs);
+  free(ptrs);
+  free(priv);
+
+  if (total_errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    if (rank == 0) printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI I/O vector coalescing test
+  *
+  * Put, accumulate and get an I/O vector whose blocks are given out of order.
+  * Blocks are contiguous on the remote side and contiguous in groups on the
+  * local side, so that only some of them can be merged.  Check the result in
+  * the right neighbor and in the local copy read back from it.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+#include <armci.h>
+
+#define NSEG  32
+#define BLK   5     /* Doubles per block                   */
+#define GROUP 4     /* Blocks that are contiguous locally  */
+#define GAP   3     /* Doubles between local block groups  */
+#define LOCAL_LEN (NSEG*BLK + (NSEG/GROUP)*GAP)
+
+/* Offset of block k in the local buffer */
+static int local_off(int k) {
+  return k*BLK + (k/GROUP)*GAP;
+}
+
+int main(int argc, char **argv) {
+  int           rank, nproc, right, left, i, k, errors = 0, total_errors;
+  void        **base_ptrs;
+  double       *src_buf, *get_buf, one = 1.0;
+  armci_giov_t  iov;
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  right = (rank+1) % nproc;
+  left  = (rank+nproc-1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI I/O vector coalescing test with %d processes\n", nproc);
+
+  base_ptrs = malloc(sizeof(void*)*nproc);
+  ARMCI_Malloc(base_ptrs, NSEG*BLK*sizeof(double));
+  src_buf = malloc(LOCAL_LEN*sizeof(double));
+  get_buf = malloc(LOCAL_LEN*sizeof(double));
+
+  for (i = 0; i < LOCAL_LEN; i++)
+    src_buf[i] = rank*1000 + i;
+
+  ARMCI_Access_begin(base_ptrs[rank]);
+  for (i = 0; i < NSEG*BLK; i++)
+    ((double*)base_ptrs[rank])[i] = -1.0;
+  ARMCI_Access_end(base_ptrs[rank]);
+
+  /* Visit the blocks in a scrambled order */
+  iov.bytes         = BLK*sizeof(double);
+  iov.ptr_array_len = NSEG;
+  iov.src_ptr_array = malloc(NSEG*sizeof(void*));
+  iov.dst_ptr_array = malloc(NSEG*sizeof(void*));
+
+  for (i = 0; i < NSEG; i++) {
+    k = (i*7) % NSEG;
+    iov.src_ptr_array[i] = &src_buf[local_off(k)];
+    iov.dst_ptr_array[i] = ((double*)base_ptrs[right]) + k*BLK;
+  }
+
+  ARMCI_Barrier();
+
+  ARMCI_PutV(&iov, 1, right);
+  ARMCI_AccV(ARMCI_ACC_DBL, &one, &iov, 1, right);
+
+  ARMCI_Barrier();
+
+  ARMCI_Access_begin(base_ptrs[rank]);
+  for (k = 0; k < NSEG && errors == 0; k++) {
+    for (i = 0; i < BLK; i++) {
+      const double actual = ((double*)base_ptrs[rank])[k*BLK + i];
+      const double expect = 2.0*(left*1000 + local_off(k) + i);
+
+      if (actual != expect) {
+        printf("%d: put/acc error in block %d at %d: %f, expected %f\n", rank, k, i, actual, expect);
+        errors++;
+        break;
+      }
+    }
+  }
+  ARMCI_Access_end(base_ptrs[rank]);
+
+  /* Read back what this process wrote, into the same local layout */
+  for (i = 0; i < LOCAL_LEN; i++)
+    get_buf[i] = -1.0;
+
+  for (i = 0; i < NSEG; i++) {
+    k = (i*7) % NSEG;
+    iov.src_ptr_array[i] = ((double*)base_ptrs[right]) + k*BLK;
+    iov.dst_ptr_array[i] = &get_buf[local_off(k)];
+  }
+
+  ARMCI_GetV(&iov, 1, right);
+
+  for (k = 0; k < NSEG && errors == 0; k++) {
+    for (i = 0; i < BLK; i++) {
+      if (get_buf[local_off(k) + i] != 2.0*src_buf[local_off(k) + i]) {
+        printf("%d: get error in block %d at %d\n", rank, k, i);
+        errors++;
+        break;
+      }
+    }
+  }
+
+  for (k = 0; k < NSEG/GROUP && errors == 0; k++) {
+    for (i = 0; i < GAP; i++) {
+      if (get_buf[local_off(k*GROUP + GROUP) - GAP + i] != -1.0) {
+        printf("%d: get wrote into the gap after group %d\n", rank, k);
+        errors++;
+        break;
+      }
+    }
+  }
+
+  ARMCI_Barrier();
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  free(iov.src_ptr_array);
+  free(iov.dst_ptr_array);
+
+  ARMCI_Free(base_ptrs[rank]);
+  free(base_ptrs);
+  free(src_buf);
+  free(get_buf);
+
+  if (total_errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    if (rank == 0) printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI irregular I/O vector test
+  *
+  * Put, accumulate and get ragged rows, stored packed (as in CSR) on the
+  * origin and at a fixed row pitch on the target, with the irregular I/O
+  * vector extensions.  The rows are split between two descriptors and the
+  * second one is given in reverse order.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+#include <armci.h>
+#include <armcix.h>
+
+#define NROWS 24
+#define PITCH 32  /* Doubles between rows on the target */
+
+/* Row r holds r % 7 doubles; empty rows are allowed */
+static int row_len(int r) {
+  return r % 7;
+}
+
+int main(int argc, char **argv) {
+  int                  rank, nproc, right, left, r, i, k, v, errors = 0, total_errors;
+  int                  row_ptr[NROWS+1];
+  void               **base_ptrs;
+  double              *src_buf, *get_buf, two = 2.0;
+  armcix_giov_irreg_t  iov[2];
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  right = (rank+1) % nproc;
+  left  = (rank+nproc-1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI irregular I/O vector test with %d processes\n", nproc);
+
+  row_ptr[0] = 0;
+  for (r = 0; r < NROWS; r++)
+    row_ptr[r+1] = row_ptr[r] + row_len(r);
+
+  base_ptrs = malloc(sizeof(void*)*nproc);
+  ARMCI_Malloc(base_ptrs, NROWS*PITCH*sizeof(double));
+  src_buf = malloc(row_ptr[NROWS]*sizeof(double));
+  get_buf = malloc(row_ptr[NROWS]*sizeof(double));
+
+  for (i = 0; i < row_ptr[NROWS]; i++)
+    src_buf[i] = rank*1000 + i;
+
+  ARMCI_Access_begin(base_ptrs[rank]);
+  for (i = 0; i < NROWS*PITCH; i++)
+    ((double*)base_ptrs[rank])[i] = -1.0;
+  ARMCI_Access_end(base_ptrs[rank]);
+
+  /* First half of the rows in order, second half reversed */
+  for (v = 0; v < 2; v++) {
+    iov[v].ptr_array_len = NROWS/2;
+    iov[v].src_ptr_array = malloc(NROWS/2*sizeof(void*));
+    iov[v].dst_ptr_array = malloc(NROWS/2*sizeof(void*));
+    iov[v].bytes_array   = malloc(NROWS/2*sizeof(int));
+  }
+
+  for (k = 0; k < NROWS/2; k++) {
+    for (v = 0; v < 2; v++) {
+      r = (v == 0) ? k : NROWS-1-k;
+      iov[v].src_ptr_array[k] = &src_buf[row_ptr[r]];
+      iov[v].dst_ptr_array[k] = ((double*)base_ptrs[right]) + r*PITCH;
+      iov[v].bytes_array[k]   = row_len(r)*sizeof(double);
+    }
+  }
+
+  ARMCI_Barrier();
+
+  /* Put, then accumulate twice the rows: the target holds 3x */
+  ARMCIX_PutV_irreg(iov, 2, right);
+  ARMCIX_AccV_irreg(ARMCI_ACC_DBL, &two, iov, 2, right);
+
+  ARMCI_Barrier();
+
+  ARMCI_Access_begin(base_ptrs[rank]);
+  for (r = 0; r < NROWS; r++) {
+    for (i = 0; i < PITCH; i++) {
+      const double actual = ((double*)base_ptrs[rank])[r*PITCH + i];
+      const double expect = (i < row_len(r)) ? 3.0*(left*1000 + row_ptr[r] + i) : -1.0;
+
+      if (actual != expect) {
+        printf("%d: put/acc error in row %d at %d: %f, expected %f\n", rank, r, i, actual, expect);
+        errors++;
+        break;
+      }
+    }
+  }
+  ARMCI_Access_end(base_ptrs[rank]);
+
+  /* Read the rows back into a packed buffer */
+  for (i = 0; i < row_ptr[NROWS]; i++)
+    get_buf[i] = -1.0;
+
+  for (k = 0; k < NROWS/2; k++) {
+    for (v = 0; v < 2; v++) {
+      void *rem = iov[v].dst_ptr_array[k];
+
+      r = (v == 0) ? k : NROWS-1-k;
+      iov[v].src_ptr_array[k] = rem;
+      iov[v].dst_ptr_array[k] = &get_buf[row_ptr[r]];
+    }
+  }
+
+  ARMCIX_GetV_irreg(iov, 2, right);
+
+  for (i = 0; i < row_ptr[NROWS]; i++) {
+    if (get_buf[i] != 3.0*src_buf[i]) {
+      printf("%d: get error at %d: %f, expected %f\n", rank, i, get_buf[i], 3.0*src_buf[i]);
+      errors++;
+      break;
+    }
+  }
+
+  ARMCI_Barrier();
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  for (v = 0; v < 2; v++) {
+    free(iov[v].src_ptr_array);
+    free(iov[v].dst_ptr_array);
+    free(iov[v].bytes_array);
+  }
+
+  ARMCI_Free(base_ptrs[rank]);
+  free(base_ptrs);
+  free(src_buf);
+  free(get_buf);
+
+  if (total_errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    if (rank == 0) printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI multiple descriptor I/O vector test
+  *
+  * Put, accumulate and get several I/O vector descriptors with different
+  * block sizes in one call.  Two descriptors target one allocation and a
+  * third targets another, so the operation spans two windows.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+#include <armci.h>
+
+#define NDESC 3
+#define NBLK  8
+#define PITCH 16  /* Doubles between blocks on the target */
+
+static const int blk_len[NDESC]  = { 3, 5, 7 };  /* Doubles per block            */
+static const int blk_off[NDESC]  = { 0, 4, 0 };  /* Offset of blocks in the pitch */
+static const int blk_arr[NDESC]  = { 0, 0, 1 };  /* Target allocation            */
+
+int main(int argc, char **argv) {
+  int           rank, nproc, right, left, d, b, i, errors = 0, total_errors;
+  void        **base_ptrs[2];
+  double       *src_buf, *get_buf, one = 1.0;
+  armci_giov_t  iov[NDESC];
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  right = (rank+1) % nproc;
+  left  = (rank+nproc-1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI multiple descriptor I/O vector test with %d processes\n", nproc);
+
+  for (i = 0; i < 2; i++) {
+    base_ptrs[i] = malloc(sizeof(void*)*nproc);
+    ARMCI_Malloc(base_ptrs[i], NBLK*PITCH*sizeof(double));
+
+    ARMCI_Access_begin(base_ptrs[i][rank]);
+    for (b = 0; b < NBLK*PITCH; b++)
+      ((double*)base_ptrs[i][rank])[b] = -1.0;
+    ARMCI_Access_end(base_ptrs[i][rank]);
+  }
+
+  /* Local blocks are PITCH doubles apart for every descriptor */
+  src_buf = malloc(NDESC*NBLK*PITCH*sizeof(double));
+  get_buf = malloc(NDESC*NBLK*PITCH*sizeof(double));
+
+  for (i = 0; i < NDESC*NBLK*PITCH; i++)
+    src_buf[i] = rank*10000 + i;
+
+  for (d = 0; d < NDESC; d++) {
+    iov[d].bytes         = blk_len[d]*sizeof(double);
+    iov[d].ptr_array_len = NBLK;
+    iov[d].src_ptr_array = malloc(NBLK*sizeof(void*));
+    iov[d].dst_ptr_array = malloc(NBLK*sizeof(void*));
+
+    for (b = 0; b < NBLK; b++) {
+      iov[d].src_ptr_array[b] = &src_buf[(d*NBLK + b)*PITCH];
+      iov[d].dst_ptr_array[b] = ((double*)base_ptrs[blk_arr[d]][right]) + b*PITCH + blk_off[d];
+    }
+  }
+
+  ARMCI_Barrier();
+
+  ARMCI_PutV(iov, NDESC, right);
+  ARMCI_AccV(ARMCI_ACC_DBL, &one, iov, NDESC, right);
+
+  ARMCI_Barrier();
+
+  for (d = 0; d < NDESC; d++) {
+    double *local = base_ptrs[blk_arr[d]][rank];
+
+    ARMCI_Access_begin(local);
+    for (b = 0; b < NBLK; b++) {
+      for (i = 0; i < blk_len[d]; i++) {
+        const double actual = local[b*PITCH + blk_off[d] + i];
+        const double expect = 2.0*(left*10000 + (d*NBLK + b)*PITCH + i);
+
+        if (actual != expect) {
+          printf("%d: put/acc error in descriptor %d, block %d at %d: %f, expected %f\n",
+                 rank, d, b, i, actual, expect);
+          errors++;
+          break;
+        }
+      }
+    }
+    ARMCI_Access_end(local);
+  }
+
+  /* Read everything back */
+  for (i = 0; i < NDESC*NBLK*PITCH; i++)
+    get_buf[i] = -1.0;
+
+  for (d = 0; d < NDESC; d++) {
+    for (b = 0; b < NBLK; b++) {
+      iov[d].src_ptr_array[b] = iov[d].dst_ptr_array[b];
+      iov[d].dst_ptr_array[b] = &get_buf[(d*NBLK + b)*PITCH];
+    }
+  }
+
+  ARMCI_GetV(iov, NDESC, right);
+
+  for (d = 0; d < NDESC; d++) {
+    for (b = 0; b < NBLK; b++) {
+      for (i = 0; i < PITCH; i++) {
+        const int    k      = (d*NBLK + b)*PITCH + i;
+        const double expect = (i < blk_len[d]) ? 2.0*src_buf[k] : -1.0;
+
+        if (get_buf[k] != expect) {
+          printf("%d: get error in descriptor %d, block %d at %d\n", rank, d, b, i);
+          errors++;
+          break;
+        }
+      }
+    }
+  }
+
+  ARMCI_Barrier();
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  for (d = 0; d < NDESC; d++) {
+    free(iov[d].src_ptr_array);
+    free(iov[d].dst_ptr_array);
+  }
+
+  for (i = 0; i < 2; i++) {
+    ARMCI_Free(base_ptrs[i][rank]);
+    free(base_ptrs[i]);
+  }
+
+  free(src_buf);
+  free(get_buf);
+
+  if (total_errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    if (rank == 0) printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}
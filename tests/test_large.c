@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI large transfer test
+  *
+  * Shrink the large transfer chunk size and exercise the ARMCIX_*_large
+  * extensions on transfers that span several chunks: directly on the window
+  * (blocking and nonblocking), through the regular routines (scaled
+  * accumulates and transfers to self) and on transfers small enough to be
+  * passed through unchanged.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+#include <armci.h>
+#include <armcix.h>
+
+#define NELT   5000  /* Doubles; spans several 4096 byte chunks */
+#define NSMALL 100   /* Doubles; fits in one chunk              */
+
+static int check(const char *name, int rank, double *buf, int n, double scale, int base) {
+  int i;
+
+  for (i = 0; i < n; i++) {
+    if (buf[i] != scale*(base + i)) {
+      printf("%d: %s error at %d: %f, expected %f\n", rank, name, i, buf[i], scale*(base + i));
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+int main(int argc, char **argv) {
+  int          rank, nproc, right, nb, i, errors = 0, total_errors;
+  void       **base_ptrs;
+  double      *src_buf, *get_buf, one = 1.0, two = 2.0;
+  armci_hdl_t  handle;
+
+  setenv("ARMCI_LARGE_CHUNK", "4096", 1);
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  right = (rank+1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI large transfer test with %d processes\n", nproc);
+
+  base_ptrs = malloc(sizeof(void*)*nproc);
+  ARMCI_Malloc(base_ptrs, NELT*sizeof(double));
+  src_buf = malloc(NELT*sizeof(double));
+  get_buf = malloc(NELT*sizeof(double));
+
+  for (i = 0; i < NELT; i++)
+    src_buf[i] = rank*NELT + i;
+
+  ARMCI_Barrier();
+
+  /* Direct path: put, accumulate and get back, blocking and nonblocking */
+  for (nb = 0; nb < 2; nb++) {
+    for (i = 0; i < NELT; i++)
+      get_buf[i] = -1.0;
+
+    if (nb) {
+      ARMCI_INIT_HANDLE(&handle);
+      ARMCIX_NbPut_large(src_buf, base_ptrs[right], NELT*sizeof(double), right, &handle);
+      ARMCI_Wait(&handle);
+      ARMCI_Fence(right);
+
+      ARMCI_INIT_HANDLE(&handle);
+      ARMCIX_NbAcc_large(ARMCI_ACC_DBL, &one, src_buf, base_ptrs[right], NELT*sizeof(double), right, &handle);
+      ARMCI_Wait(&handle);
+      ARMCI_Fence(right);
+
+      ARMCI_INIT_HANDLE(&handle);
+      ARMCIX_NbGet_large(base_ptrs[right], get_buf, NELT*sizeof(double), right, &handle);
+      ARMCI_Wait(&handle);
+    } else {
+      ARMCIX_Put_large(src_buf, base_ptrs[right], NELT*sizeof(double), right);
+      ARMCI_Fence(right);
+      ARMCIX_Acc_large(ARMCI_ACC_DBL, &one, src_buf, base_ptrs[right], NELT*sizeof(double), right);
+      ARMCI_Fence(right);
+      ARMCIX_Get_large(base_ptrs[right], get_buf, NELT*sizeof(double), right);
+    }
+
+    errors += check(nb ? "nonblocking direct" : "direct", rank, get_buf, NELT, 2.0, rank*NELT);
+  }
+
+  /* Scaled accumulates are split into regular accumulates */
+  ARMCIX_Acc_large(ARMCI_ACC_DBL, &two, src_buf, base_ptrs[right], NELT*sizeof(double), right);
+  ARMCI_Fence(right);
+  ARMCIX_Get_large(base_ptrs[right], get_buf, NELT*sizeof(double), right);
+
+  errors += check("scaled accumulate", rank, get_buf, NELT, 4.0, rank*NELT);
+
+  /* Small transfers are passed through to the regular routines */
+  for (i = 0; i < NELT; i++)
+    get_buf[i] = -1.0;
+
+  ARMCIX_Get_large(base_ptrs[right], get_buf, NSMALL*sizeof(double), right);
+
+  errors += check("small get", rank, get_buf, NSMALL, 4.0, rank*NELT);
+
+  if (get_buf[NSMALL] != -1.0) {
+    printf("%d: small get wrote past its end\n", rank);
+    errors++;
+  }
+
+  ARMCI_Barrier();
+
+  /* Transfers to self are split into regular transfers */
+  ARMCIX_Put_large(src_buf, base_ptrs[rank], NELT*sizeof(double), rank);
+  ARMCIX_Get_large(base_ptrs[rank], get_buf, NELT*sizeof(double), rank);
+
+  errors += check("self", rank, get_buf, NELT, 1.0, rank*NELT);
+
+  ARMCI_Barrier();
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  ARMCI_Free(base_ptrs[rank]);
+  free(base_ptrs);
+  free(src_buf);
+  free(get_buf);
+
+  if (total_errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    if (rank == 0) printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}
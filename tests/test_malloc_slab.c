@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI slab allocation test
+  * 
+  * Enable slab suballocation, perform a pile of small and large allocations,
+  * write into each of them with put, and free them out of order.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+#include <armci.h>
+
+#define NUM_ALLOCS     40
+#define MAX_NELTS      2048
+
+static int alloc_nelts(int i) {
+  /* Mix of empty, small (slab) and large (window) allocations */
+  if (i % 7 == 0)
+    return 0;
+  else if (i % 5 == 0)
+    return MAX_NELTS;
+  else
+    return 8*(i+1);
+}
+
+int main(int argc, char ** argv) {
+  int     rank, nproc, i, j, errors = 0;
+  void ***base_ptrs;
+
+  setenv("ARMCI_SLAB_THRESHOLD", "4096", 1);
+  setenv("ARMCI_SLAB_SIZE", "16384", 1);
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  if (rank == 0) printf("Starting ARMCI slab allocation test with %d processes\n", nproc);
+
+  base_ptrs = malloc(sizeof(void**)*NUM_ALLOCS);
+
+  for (i = 0; i < NUM_ALLOCS; i++) {
+    base_ptrs[i] = malloc(sizeof(void*)*nproc);
+    ARMCI_Malloc(base_ptrs[i], alloc_nelts(i)*sizeof(int));
+  }
+
+  // Free every third allocation and reallocate it to reuse slab space
+  for (i = 0; i < NUM_ALLOCS; i += 3) {
+    ARMCI_Free(base_ptrs[i][rank]);
+    ARMCI_Malloc(base_ptrs[i], alloc_nelts(i)*sizeof(int));
+  }
+
+  // Write my rank into each allocation on my right neighbor
+  for (i = 0; i < NUM_ALLOCS; i++) {
+    int nelts = alloc_nelts(i);
+    int buf[MAX_NELTS];
+
+    if (nelts == 0) continue;
+
+    for (j = 0; j < nelts; j++)
+      buf[j] = rank*NUM_ALLOCS + i;
+
+    ARMCI_Put(buf, base_ptrs[i][(rank+1) % nproc], nelts*sizeof(int), (rank+1) % nproc);
+  }
+
+  ARMCI_Barrier();
+
+  for (i = 0; i < NUM_ALLOCS; i++) {
+    int  nelts = alloc_nelts(i);
+    int  left  = (rank+nproc-1) % nproc;
+    int *data  = base_ptrs[i][rank];
+
+    if (nelts == 0) continue;
+
+    ARMCI_Access_begin(data);
+    for (j = 0; j < nelts; j++) {
+      if (data[j] != left*NUM_ALLOCS + i) {
+        printf("%d: Error in allocation %d, element %d: expected %d, got %d\n",
+               rank, i, j, left*NUM_ALLOCS + i, data[j]);
+        errors++;
+        break;
+      }
+    }
+    ARMCI_Access_end(data);
+  }
+
+  ARMCI_Barrier();
+
+  for (i = NUM_ALLOCS-1; i >= 0; i--) {
+    ARMCI_Free(base_ptrs[i][rank]);
+    free(base_ptrs[i]);
+  }
+
+  free(base_ptrs);
+
+  if (errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    printf("%d: Fail\n", rank);
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return errors != 0;
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI nonblocking handle test
+  * 
+  * Issue nonblocking gets from several allocations with explicit aggregate and
+  * non-aggregate handles, interleave them with implicit puts, and check that
+  * waiting on (or testing) each handle completes exactly the gets it covers.
+  * Finish with scaled accumulates whose temporary buffers are retired by wait.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+#include <armci.h>
+
+#define NUM_ALLOCS     8
+#define NELTS          256
+
+int main(int argc, char ** argv) {
+  int         rank, nproc, i, j, errors = 0;
+  int         right, left, scale;
+  void     ***base_ptrs;
+  int         get_buf[NUM_ALLOCS][NELTS];
+  int         put_buf[NELTS];
+  armci_hdl_t agg_handle, handles[NUM_ALLOCS];
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  right = (rank+1) % nproc;
+  left  = (rank+nproc-1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI nonblocking handle test with %d processes\n", nproc);
+
+  base_ptrs = malloc(sizeof(void**)*NUM_ALLOCS);
+
+  for (i = 0; i < NUM_ALLOCS; i++) {
+    int *data;
+
+    base_ptrs[i] = malloc(sizeof(void*)*nproc);
+    ARMCI_Malloc(base_ptrs[i], 2*NELTS*sizeof(int));
+
+    data = base_ptrs[i][rank];
+    ARMCI_Access_begin(data);
+    for (j = 0; j < 2*NELTS; j++)
+      data[j] = rank*NUM_ALLOCS + i;
+    ARMCI_Access_end(data);
+  }
+
+  ARMCI_Barrier();
+
+  // One non-aggregate handle per allocation, plus implicit puts into the
+  // second half of each allocation on the left neighbor
+  for (i = 0; i < NUM_ALLOCS; i++) {
+    ARMCI_INIT_HANDLE(&handles[i]);
+    ARMCI_UNSET_AGGREGATE_HANDLE(&handles[i]);
+    ARMCI_NbGet(base_ptrs[i][right], get_buf[i], NELTS*sizeof(int), right, &handles[i]);
+
+    for (j = 0; j < NELTS; j++)
+      put_buf[j] = -rank;
+
+    ARMCI_NbPut(put_buf, ((int*)base_ptrs[i][left]) + NELTS, NELTS*sizeof(int), left, NULL);
+    ARMCI_WaitAll();
+  }
+
+  for (i = NUM_ALLOCS-1; i >= 0; i--) {
+    ARMCI_Wait(&handles[i]);
+
+    for (j = 0; j < NELTS; j++) {
+      if (get_buf[i][j] != right*NUM_ALLOCS + i) {
+        printf("%d: Error in handle %d, element %d: expected %d, got %d\n",
+               rank, i, j, right*NUM_ALLOCS + i, get_buf[i][j]);
+        errors++;
+        break;
+      }
+    }
+  }
+
+  // One aggregate handle covering gets from every allocation
+  ARMCI_INIT_HANDLE(&agg_handle);
+
+  for (i = 0; i < NUM_ALLOCS; i++)
+    ARMCI_NbGet(base_ptrs[i][right], get_buf[i], NELTS*sizeof(int), right, &agg_handle);
+
+  // ARMCI_Test returns zero once the handle is complete
+  while (ARMCI_Test(&agg_handle))
+    ;
+
+  for (i = 0; i < NUM_ALLOCS; i++) {
+    for (j = 0; j < NELTS; j++) {
+      if (get_buf[i][j] != right*NUM_ALLOCS + i) {
+        printf("%d: Error in aggregate get %d, element %d: expected %d, got %d\n",
+               rank, i, j, right*NUM_ALLOCS + i, get_buf[i][j]);
+        errors++;
+        break;
+      }
+    }
+  }
+
+  ARMCI_Barrier();
+
+  // Check the implicit puts from the right neighbor
+  for (i = 0; i < NUM_ALLOCS; i++) {
+    int *data = ((int*)base_ptrs[i][rank]) + NELTS;
+
+    ARMCI_Access_begin(data);
+    for (j = 0; j < NELTS; j++) {
+      if (data[j] != -right) {
+        printf("%d: Error in put %d, element %d: expected %d, got %d\n",
+               rank, i, j, -right, data[j]);
+        errors++;
+        break;
+      }
+    }
+    ARMCI_Access_end(data);
+  }
+
+  ARMCI_Barrier();
+
+  // Scaled accumulates into the first half of two allocations on the left
+  // neighbor, one with an explicit and one with an implicit handle.  Their
+  // scaled copies stay alive until the handles are waited on.
+  scale = 2;
+  for (j = 0; j < NELTS; j++)
+    put_buf[j] = 1;
+
+  ARMCI_INIT_HANDLE(&agg_handle);
+  ARMCI_NbAcc(ARMCI_ACC_INT, &scale, put_buf, base_ptrs[0][left], NELTS*sizeof(int), left, &agg_handle);
+  ARMCI_NbAcc(ARMCI_ACC_INT, &scale, put_buf, base_ptrs[1][left], NELTS*sizeof(int), left, NULL);
+
+  ARMCI_Wait(&agg_handle);
+  ARMCI_WaitAll();
+  ARMCI_Barrier();
+
+  for (i = 0; i < 2; i++) {
+    int *data = base_ptrs[i][rank];
+
+    ARMCI_Access_begin(data);
+    for (j = 0; j < NELTS; j++) {
+      if (data[j] != rank*NUM_ALLOCS + i + 2) {
+        printf("%d: Error in scaled acc %d, element %d: expected %d, got %d\n",
+               rank, i, j, rank*NUM_ALLOCS + i + 2, data[j]);
+        errors++;
+        break;
+      }
+    }
+    ARMCI_Access_end(data);
+  }
+
+  ARMCI_Barrier();
+
+  for (i = 0; i < NUM_ALLOCS; i++) {
+    ARMCI_Free(base_ptrs[i][rank]);
+    free(base_ptrs[i]);
+  }
+
+  free(base_ptrs);
+
+  if (errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    printf("%d: Fail\n", rank);
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return errors != 0;
+}
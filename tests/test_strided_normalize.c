@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2010. See COPYRIGHT in top-level directory.
+ */
+
+/** ARMCI degenerate strided descriptor test
+  *
+  * Strided operations whose descriptors contain unit counts, or strides equal
+  * to the extent of the lower dimensions, are normalized before they are
+  * issued.  Put, get and accumulate a patch described in several such ways
+  * into the right neighbor and check the result.
+  */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <mpi.h>
+#include <armci.h>
+
+#define NCOLS 8   /* Doubles per row     */
+#define NROWS 6
+#define LDA   16  /* Doubles between rows */
+#define NCASES 4
+
+typedef struct {
+  const char *name;
+  int         levels;
+  int         count[4];
+  int         stride[3];
+  int         contig;  /* Rows are packed (stride = row length) */
+} desc_t;
+
+static const desc_t cases[NCASES] = {
+  /* Fully contiguous written as two levels */
+  { "contig",      2, { NCOLS*sizeof(double), NROWS, 1, 0 },
+                      { NCOLS*sizeof(double), NCOLS*NROWS*sizeof(double), 0 }, 1 },
+  /* Unit count in the middle of a strided patch */
+  { "unit-middle", 2, { NCOLS*sizeof(double), 1, NROWS, 0 },
+                      { 3*sizeof(double), LDA*sizeof(double), 0 }, 0 },
+  /* Leading unit count, then rows */
+  { "unit-lead",   3, { NCOLS*sizeof(double), 1, NROWS, 1 },
+                      { 5*sizeof(double), LDA*sizeof(double), 7*sizeof(double) }, 0 },
+  /* Contiguous halves merged into one level */
+  { "merge",       2, { NCOLS*sizeof(double), NROWS/2, 2, 0 },
+                      { NCOLS*sizeof(double), NCOLS*(NROWS/2)*sizeof(double), 0 }, 1 },
+};
+
+int main(int argc, char **argv) {
+  int      rank, nproc, right, left, c, i, j, errors = 0, total_errors;
+  void   **base_ptrs;
+  double  *src_buf, *get_buf, one = 1.0;
+
+  MPI_Init(&argc, &argv);
+  ARMCI_Init();
+
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nproc);
+
+  right = (rank+1) % nproc;
+  left  = (rank+nproc-1) % nproc;
+
+  if (rank == 0) printf("Starting ARMCI degenerate strided descriptor test with %d processes\n", nproc);
+
+  base_ptrs = malloc(sizeof(void*)*nproc);
+  ARMCI_Malloc(base_ptrs, NROWS*LDA*sizeof(double));
+  src_buf = malloc(NROWS*LDA*sizeof(double));
+  get_buf = malloc(NROWS*LDA*sizeof(double));
+
+  for (c = 0; c < NCASES; c++) {
+    const desc_t *d   = &cases[c];
+    const int     lda = d->contig ? NCOLS : LDA;
+    double       *local = base_ptrs[rank];
+    int           stride[3];
+
+    for (i = 0; i < d->levels; i++)
+      stride[i] = d->stride[i];
+
+    ARMCI_Access_begin(local);
+    for (i = 0; i < NROWS*LDA; i++)
+      local[i] = -1.0;
+    ARMCI_Access_end(local);
+
+    for (i = 0; i < NROWS*LDA; i++)
+      src_buf[i] = rank*1000 + i;
+
+    ARMCI_Barrier();
+
+    /* Put, then accumulate the same patch once more */
+    ARMCI_PutS(src_buf, stride, base_ptrs[right], stride, (int*) d->count, d->levels, right);
+    ARMCI_AccS(ARMCI_ACC_DBL, &one, src_buf, stride, base_ptrs[right], stride, (int*) d->count, d->levels, right);
+
+    ARMCI_Barrier();
+
+    ARMCI_Access_begin(local);
+    for (i = 0; i < NROWS; i++) {
+      for (j = 0; j < lda; j++) {
+        const double expect = (j < NCOLS) ? 2.0*(left*1000 + i*lda + j) : -1.0;
+
+        if (local[i*lda + j] != expect) {
+          printf("%d: %s put/acc error at [%d, %d]: %f, expected %f\n", rank, d->name, i, j,
+                 local[i*lda + j], expect);
+          errors++;
+          break;
+        }
+      }
+    }
+    ARMCI_Access_end(local);
+
+    /* Get it back from the left neighbor's copy on the right */
+    for (i = 0; i < NROWS*LDA; i++)
+      get_buf[i] = -1.0;
+
+    ARMCI_GetS(base_ptrs[right], stride, get_buf, stride, (int*) d->count, d->levels, right);
+
+    for (i = 0; i < NROWS; i++) {
+      for (j = 0; j < NCOLS; j++) {
+        if (get_buf[i*lda + j] != 2.0*(rank*1000 + i*lda + j)) {
+          printf("%d: %s get error at [%d, %d]\n", rank, d->name, i, j);
+          errors++;
+          break;
+        }
+      }
+    }
+
+    ARMCI_Barrier();
+  }
+
+  MPI_Allreduce(&errors, &total_errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+
+  ARMCI_Free(base_ptrs[rank]);
+  free(base_ptrs);
+  free(src_buf);
+  free(get_buf);
+
+  if (total_errors == 0) {
+    if (rank == 0) printf("Test complete: PASS.\n");
+  } else {
+    if (rank == 0) printf("Test complete: FAIL.\n");
+  }
+
+  ARMCI_Finalize();
+  MPI_Finalize();
+
+  return total_errors != 0;
+}